@@ -0,0 +1,409 @@
+#include "compiler.h"
+
+using namespace std;
+
+Compiler::Compiler(IdentifiersTable& identifiersTable, vector<Lexeme>& rpn) {
+	this->identifiersTable = identifiersTable;
+	this->rpn = rpn;
+}
+
+OpCode Compiler::keywordOpCode(const string& lexV) const {
+	if (lexV == LEX_NOT)
+		return OpCode::logic_not;
+
+	if (lexV == LEX_READ)
+		return OpCode::read;
+
+	if (lexV == LEX_WRITE)
+		return OpCode::write;
+
+	throw "Unknown keyword '" + lexV + "' in reverse polish notation";
+}
+
+// operands of ariphmetics and comparisons are already converted to one type by syntax analyzer
+OpCode Compiler::delimeterOpCode(const string& lexV, IdentifierT type) const {
+	if (lexV == LEX_EQUALS)
+		return OpCode::assign;
+
+	if (type == IdentifierT::identifier_int) {
+		if (lexV == LEX_PLUS)
+			return OpCode::add_int;
+
+		if (lexV == LEX_MINUS)
+			return OpCode::sub_int;
+
+		if (lexV == LEX_MULT)
+			return OpCode::mult_int;
+
+		if (lexV == LEX_DIV)
+			return OpCode::div_int;
+
+		if (lexV == LEX_MOD)
+			return OpCode::mod_int;
+
+		if (lexV == LEX_EQUAL)
+			return OpCode::equal_int;
+
+		if (lexV == LEX_NEQUAL)
+			return OpCode::nequal_int;
+
+		if (lexV == LEX_LESS)
+			return OpCode::less_int;
+
+		if (lexV == LEX_GREATER)
+			return OpCode::greater_int;
+
+		if (lexV == LEX_LESS_EQUAL)
+			return OpCode::less_equal_int;
+
+		if (lexV == LEX_GREATER_EQUAL)
+			return OpCode::greater_equal_int;
+	}
+	else if (type == IdentifierT::identifier_real) {
+		if (lexV == LEX_PLUS)
+			return OpCode::add_real;
+
+		if (lexV == LEX_MINUS)
+			return OpCode::sub_real;
+
+		if (lexV == LEX_MULT)
+			return OpCode::mult_real;
+
+		if (lexV == LEX_DIV)
+			return OpCode::div_real;
+
+		if (lexV == LEX_EQUAL)
+			return OpCode::equal_real;
+
+		if (lexV == LEX_NEQUAL)
+			return OpCode::nequal_real;
+
+		if (lexV == LEX_LESS)
+			return OpCode::less_real;
+
+		if (lexV == LEX_GREATER)
+			return OpCode::greater_real;
+
+		if (lexV == LEX_LESS_EQUAL)
+			return OpCode::less_equal_real;
+
+		if (lexV == LEX_GREATER_EQUAL)
+			return OpCode::greater_equal_real;
+	}
+	else if (type == IdentifierT::identifier_string) {
+		if (lexV == LEX_PLUS)
+			return OpCode::concat;
+
+		if (lexV == LEX_EQUAL)
+			return OpCode::equal_string;
+
+		if (lexV == LEX_NEQUAL)
+			return OpCode::nequal_string;
+
+		if (lexV == LEX_LESS)
+			return OpCode::less_string;
+
+		if (lexV == LEX_GREATER)
+			return OpCode::greater_string;
+	}
+
+	throw "Unknown delimeter '" + lexV + "' in reverse polish notation";
+}
+
+OpCode Compiler::shortOpCode(const string& lexV, IdentifierT type) const {
+	if (type == IdentifierT::identifier_int) {
+		if (lexV == LEX_PLUS)
+			return OpCode::add_value_int;
+
+		if (lexV == LEX_MINUS)
+			return OpCode::sub_value_int;
+
+		if (lexV == LEX_MULT)
+			return OpCode::mult_value_int;
+
+		if (lexV == LEX_DIV)
+			return OpCode::div_value_int;
+	}
+	else if (type == IdentifierT::identifier_real) {
+		if (lexV == LEX_PLUS)
+			return OpCode::add_value_real;
+
+		if (lexV == LEX_MINUS)
+			return OpCode::sub_value_real;
+
+		if (lexV == LEX_MULT)
+			return OpCode::mult_value_real;
+
+		if (lexV == LEX_DIV)
+			return OpCode::div_value_real;
+	}
+	else if (type == IdentifierT::identifier_string && lexV == LEX_PLUS)
+		return OpCode::concat_value;
+
+	throw "Unknown short operation '" + lexV + "' in reverse polish notation";
+}
+
+OpCode Compiler::castOpCode(IdentifierT fromType, const string& toType) const {
+	if (fromType == IdentifierT::identifier_int) {
+		if (toType == LEX_REAL)
+			return OpCode::int_to_real;
+
+		if (toType == LEX_STRING)
+			return OpCode::int_to_string;
+	}
+	else if (fromType == IdentifierT::identifier_real) {
+		if (toType == LEX_INT)
+			return OpCode::real_to_int;
+
+		if (toType == LEX_STRING)
+			return OpCode::real_to_string;
+	}
+
+	throw "Unknown cast to '" + toType + "' in reverse polish notation";
+}
+
+int Compiler::getSlot(const string& name) {
+	Identifier* ident = identifiersTable.getByName(name);
+
+	if (ident == nullptr || ident->getSlot() < 0)
+		throw "Undefined identifier '" + name + "' in reverse polish notation";
+
+	return ident->getSlot();
+}
+
+int Compiler::popAddress() {
+	if (addresses.empty())
+		throw string("Expected address of identifier in reverse polish notation");
+
+	int slot = addresses.top();
+	addresses.pop();
+
+	return slot;
+}
+
+int Compiler::popLabel() {
+	if (label < 0)
+		throw string("Expected label before jump in reverse polish notation");
+
+	int target = label;
+	label = -1;
+
+	return target;
+}
+
+void Compiler::compileLexeme(const Lexeme& lexeme) {
+	Lexeme lex = lexeme;
+	string& lexV = lex.getValue();
+	vector<Instruction>& instructions = program.instructions;
+
+	switch (lex.getType()) {
+		case LexemeT::constant_int:
+		case LexemeT::constant_real:
+		case LexemeT::constant_string:
+		case LexemeT::constant_boolean:
+			instructions.push_back(Instruction(OpCode::push, program.addConstant(Value(lex.constantToIdentifier(), lexV))));
+			break;
+
+		case LexemeT::rpn_label:
+			label = stoi(lexV);
+			break;
+
+		case LexemeT::rpn_address:
+			addresses.push(getSlot(lexV));
+			break;
+
+		case LexemeT::identifier:
+			instructions.push_back(Instruction(OpCode::load, getSlot(lexV)));
+			break;
+
+		case LexemeT::rpn_minus:
+			instructions.push_back(Instruction(lex.getValueType() == IdentifierT::identifier_real ? OpCode::minus_real : OpCode::minus_int));
+			break;
+
+		case LexemeT::rpn_short_op:
+			instructions.push_back(Instruction(shortOpCode(lexV, lex.getValueType()), popAddress()));
+			break;
+
+		case LexemeT::rpn_cast:
+			instructions.push_back(Instruction(castOpCode(lex.getValueType(), lexV)));
+			break;
+
+		case LexemeT::rpn_increment:
+			instructions.push_back(Instruction(OpCode::increment, popAddress()));
+			break;
+
+		case LexemeT::rpn_decrement:
+			instructions.push_back(Instruction(OpCode::decrement, popAddress()));
+			break;
+
+		case LexemeT::keyword: {
+			OpCode opcode = keywordOpCode(lexV);
+
+			instructions.push_back(Instruction(opcode, opcode == OpCode::read ? popAddress() : 0));
+			break;
+		}
+
+		case LexemeT::delimeter: {
+			OpCode opcode = delimeterOpCode(lexV, lex.getValueType());
+
+			instructions.push_back(Instruction(opcode, opcode == OpCode::assign ? popAddress() : 0));
+			break;
+		}
+
+		case LexemeT::rpn_fgo:
+			instructions.push_back(Instruction(OpCode::fgo, popLabel()));
+			break;
+
+		case LexemeT::rpn_go:
+			instructions.push_back(Instruction(OpCode::go, popLabel()));
+			break;
+
+		default:
+			throw "Unexpected lexeme " + lex.printForRPN(false) + " in reverse polish notation";
+	}
+}
+
+void Compiler::compileVariables() {
+	for (auto i = identifiersTable.identifiers.begin(); i < identifiersTable.identifiers.end(); i++) {
+		int slot = i->getSlot();
+
+		if (slot < 0)
+			continue;
+
+		if ((size_t) slot >= program.variables.size()) {
+			program.names.resize(slot + 1);
+			program.variables.resize(slot + 1);
+		}
+
+		program.names[slot] = i->getName();
+		program.variables[slot] = i->getValue();
+	}
+}
+
+// labels of rpn point to lexemes, but labels and addresses don't produce instructions, so targets are shifted
+void Compiler::resolveJumps() {
+	for (size_t i = 0; i < program.size(); i++) {
+		Instruction& instruction = program.instructions[i];
+
+		if (instruction.isJump())
+			instruction.arg = positions[instruction.arg];
+	}
+}
+
+bool Compiler::isIntOperation(OpCode opcode) const {
+	return (opcode >= OpCode::add_int && opcode <= OpCode::mod_int) || isIntComparison(opcode);
+}
+
+bool Compiler::isIntComparison(OpCode opcode) const {
+	return opcode >= OpCode::equal_int && opcode <= OpCode::greater_equal_int;
+}
+
+// sequence can be fused only if no jump leads into the middle of it
+bool Compiler::canFuse(size_t index, size_t length, const vector<bool>& targets) const {
+	if (index + length > program.size())
+		return false;
+
+	for (size_t i = index + 1; i < index + length; i++)
+		if (targets[i])
+			return false;
+
+	return true;
+}
+
+// replace the most frequent sequences of instructions by superinstructions
+void Compiler::fuseInstructions() {
+	vector<Instruction>& code = program.instructions;
+	vector<bool> targets(code.size() + 1, false);
+
+	for (size_t i = 0; i < code.size(); i++)
+		if (code[i].isJump())
+			targets[code[i].arg] = true;
+
+	vector<Instruction> fused;
+	vector<unsigned long> positions;
+	size_t i = 0;
+
+	while (i < code.size()) {
+		Instruction instruction = code[i];
+		size_t length = 1;
+
+		if (canFuse(i, 4, targets) && code[i].opcode == OpCode::load && code[i + 1].opcode == OpCode::push && 
+			isIntComparison(code[i + 2].opcode) && code[i + 3].opcode == OpCode::fgo) {
+			instruction = Instruction(OpCode::slot_const_int_fgo, code[i + 2].opcode, code[i].arg, code[i + 1].arg, code[i + 3].arg);
+			length = 4;
+		}
+		else if (canFuse(i, 3, targets) && code[i].opcode == OpCode::load && code[i + 1].opcode == OpCode::push && isIntOperation(code[i + 2].opcode)) {
+			instruction = Instruction(OpCode::slot_const_int, code[i + 2].opcode, code[i].arg, code[i + 1].arg);
+			length = 3;
+		}
+		else if (canFuse(i, 3, targets) && code[i].opcode == OpCode::push && isIntComparison(code[i + 1].opcode) && code[i + 2].opcode == OpCode::fgo) {
+			instruction = Instruction(OpCode::const_int_fgo, code[i + 1].opcode, -1, code[i].arg, code[i + 2].arg);
+			length = 3;
+		}
+		else if (canFuse(i, 2, targets) && code[i].opcode == OpCode::increment && code[i + 1].opcode == OpCode::go) {
+			instruction = Instruction(OpCode::inc_go, OpCode::nop, code[i].arg, -1, code[i + 1].arg);
+			length = 2;
+		}
+
+		instruction.line = code[i].line;
+
+		for (size_t j = 0; j < length; j++)
+			positions.push_back(fused.size());
+
+		fused.push_back(instruction);
+		i += length;
+	}
+
+	positions.push_back(fused.size());
+
+	for (size_t j = 0; j < fused.size(); j++)
+		if (fused[j].isJump())
+			fused[j].arg = positions[fused[j].arg];
+
+	code = fused;
+}
+
+// walk all execution paths and find maximum depth of operand stack
+void Compiler::printProgram() const {
+	cout << BOLDMAGENTA << endl << "Compiled program (" << program.size() << " instructions, stack size " << program.stackSize << "):" << RESET << endl;
+	cout << program << endl;
+}
+
+Program& Compiler::compile(bool fuse) {
+	program = Program();
+	positions.clear();
+	addresses = stack<int>();
+	label = -1;
+
+	compileVariables();
+
+	unsigned long line = 0;
+
+	for (size_t i = 0; i < rpn.size(); i++) {
+		positions.push_back(program.size());
+		compileLexeme(rpn[i]);
+
+		// lexemes generated by analyzers (jumps, casts, assignments) have no line and belong to the previous one
+		if (rpn[i].getLineNumber())
+			line = rpn[i].getLineNumber();
+
+		for (size_t j = positions.back(); j < program.size(); j++)
+			program.instructions[j].line = line;
+	}
+
+	positions.push_back(program.size());
+	program.instructions.push_back(Instruction(OpCode::halt));
+	program.instructions.back().line = line;
+
+	if (!addresses.empty())
+		throw string("Address of identifier without operation in reverse polish notation");
+
+	resolveJumps();
+
+	if (fuse)
+		fuseInstructions();
+
+	program.stackSize = Program::computeStackSize(program.getCode(), program.size());
+
+	return program;
+}
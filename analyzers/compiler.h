@@ -0,0 +1,53 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stack>
+#include <algorithm>
+
+#include "../enums.h"
+#include "../entities/lexeme.h"
+#include "../entities/identifiersTable.h"
+#include "../entities/instruction.h"
+#include "../entities/program.h"
+#include "../entities/value.h"
+
+class Compiler {
+	IdentifiersTable identifiersTable;
+	std::vector<Lexeme> rpn; // reverse polish notation
+	Program program;
+
+	std::vector<unsigned long> positions; // index of first instruction for each lexeme of rpn
+	std::stack<int> addresses; // slots of identifiers waiting for operation
+	int label; // target of next go or fgo (-1 if there is no label)
+
+	OpCode keywordOpCode(const std::string& lexV) const;
+	OpCode delimeterOpCode(const std::string& lexV, IdentifierT type) const;
+	OpCode shortOpCode(const std::string& lexV, IdentifierT type) const;
+	OpCode castOpCode(IdentifierT fromType, const std::string& toType) const;
+
+	int getSlot(const std::string& name);
+	int popAddress();
+	int popLabel();
+
+	void compileVariables();
+
+	void compileLexeme(const Lexeme& lexeme);
+	void resolveJumps();
+
+	bool isIntOperation(OpCode opcode) const;
+	bool isIntComparison(OpCode opcode) const;
+	bool canFuse(size_t index, size_t length, const std::vector<bool>& targets) const;
+	void fuseInstructions();
+
+public:
+	Compiler(IdentifiersTable& identifiersTable, std::vector<Lexeme>& rpn);
+
+	void printProgram() const;
+
+	Program& compile(bool fuse = true);
+};
+
+#endif
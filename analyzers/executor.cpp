@@ -2,509 +2,904 @@
 
 using namespace std;
 
-Executor::Executor(IdentifiersTable& identifiersTable, vector<Lexeme>& rpn) {
+Executor::Executor(const IdentifiersTable& identifiersTable, const Program& program, size_t bufferSize, bool lineBuffered) {
 	this->identifiersTable = identifiersTable;
-	this->rpn = rpn;
+	this->input = &ownInput;
+	this->program = &program;
+	this->variables = program.variables;
+	this->stack = vector<Value>(program.stackSize);
+	this->stackSize = 0;
+
+	output.setCapacity(bufferSize);
+	output.setLineBuffered(lineBuffered);
 }
 
-string Executor::realToString(LongDouble v) const {
-	return v.toString();
+void Executor::push(const Value& value) {
+	stack[stackSize++] = value;
 }
 
-string Executor::intToString(LongInt v) const {
-	return v.toString();
+Value& Executor::top(size_t depth) {
+	return stack[stackSize - 1 - depth];
 }
 
-LongDouble Executor::stringToReal(const string& v) const {
-	return LongDouble(v);
+void Executor::executeIdentifiers(int slot) {
+	push(variables[slot]);
 }
 
-LongInt Executor::stringToInt(const string& v) const {
-	return LongInt(v);
+void Executor::executeIntMinus() {
+	Integer& v = top().getInt();
+
+	v = -v;
 }
 
-LongInt Executor::lexemeToInt(Lexeme& lexeme) {
-	LexemeT lexT = lexeme.getType();
+void Executor::executeRealMinus() {
+	LongDouble& v = top().getReal();
 
-	if (lexT == LexemeT::constant_int || lexT == LexemeT::rpn_label)
-		return stringToInt(lexeme.getValue());
-	
-	throw string("Expected int lexeme");
+	v = -v;
 }
 
-LongDouble Executor::lexemeToReal(Lexeme& lexeme) {
-	LexemeT lexT = lexeme.getType();
+void Executor::executeIncDec(int slot, int value) {
+	Integer& v = variables[slot].getInt();
 
-	if (lexT == LexemeT::constant_real || lexT == LexemeT::constant_int)
-		return stringToReal(lexeme.getValue());
-	
-	throw string("Expected real lexeme");
+	v = v + value;
 }
 
-bool Executor::lexemeToBool(Lexeme& lexeme) {
-	if (lexeme.getType()== LexemeT::constant_boolean)
-		return lexeme.getValue() == LEX_TRUE;
-
-	throw string("Expected boolean lexeme");
+void Executor::executeIntShortOp(OpCode opcode, int slot) {
+	Integer& v1 = top().getInt();
+	Integer& v2 = variables[slot].getInt();
+	stackSize--;
+
+	if (opcode == OpCode::add_value_int)
+		v2 = v2 + v1;
+	else if (opcode == OpCode::sub_value_int)
+		v2 = v2 - v1;
+	else if (opcode == OpCode::mult_value_int)
+		v2 = v2 * v1;
+	else if (!v1.isZero())
+		v2 = v2 / v1;
+	else
+		throw string("Division by zero");
 }
 
-string Executor::lexemeToString(Lexeme& lexeme) {
-	if (lexeme.getType() == LexemeT::constant_string)
-		return lexeme.getValue();
+void Executor::executeRealShortOp(OpCode opcode, int slot) {
+	LongDouble& v1 = top().getReal();
+	LongDouble& v2 = variables[slot].getReal();
+	stackSize--;
+
+	if (opcode == OpCode::add_value_real)
+		v2 = v2 + v1;
+	else if (opcode == OpCode::sub_value_real)
+		v2 = v2 - v1;
+	else if (opcode == OpCode::mult_value_real)
+		v2 = v2 * v1;
+	else if (v1 != 0)
+		v2 = v2 / v1;
+	else
+		throw string("Division by zero");
+}
 
-	throw string("Expected string lexeme");
+void Executor::executeConcatValue(int slot) {
+	variables[slot].getString() += top().getString();
+	stackSize--;
 }
 
-IdentifierT Executor::getLexemeType(Lexeme& lexeme) {
-	LexemeT lexT = lexeme.getType();
+void Executor::executeNot() {
+	Value& arg = top();
 
-	switch (lexT) {
-		case LexemeT::constant_int:
-			return IdentifierT::identifier_int;
+	arg = Value(!arg.getBool());
+}
 
-		case LexemeT::constant_real:
-			return IdentifierT::identifier_real;
+// result of operation replaces left argument
+void Executor::calculateInt(OpCode opcode, Integer& left, const Integer& right) {
+	if (opcode == OpCode::add_int)
+		left = left + right;
+	else if (opcode == OpCode::sub_int)
+		left = left - right;
+	else if (opcode == OpCode::mult_int)
+		left = left * right;
+	else if (!right.isZero())
+		left = (opcode == OpCode::div_int) ? (left / right) : (left % right);
+	else
+		throw string("Division by zero");
+}
 
-		case LexemeT::constant_string:
-			return IdentifierT::identifier_string;
+bool Executor::compareInt(OpCode opcode, const Value& left, const Value& right) {
+	const Integer& v1 = right.getInt();
+	const Integer& v2 = left.getInt();
 
-		case LexemeT::constant_boolean:
-			return IdentifierT::identifier_boolean;
+	if (opcode == OpCode::equal_int || opcode == OpCode::nequal_int) {
+		bool res;
 
-		case LexemeT::identifier:
-		case LexemeT::rpn_address:
-			return identifiersTable.getByName(lexeme.getValue())->getType();
+		// long numbers are compared as reals, so -0 is equal to 0
+		if (v1.isBig() || v2.isBig())
+			res = left.toReal() == right.toReal();
+		else
+			res = v1 == v2;
 
-		default:
-			return IdentifierT::identifier_unknown;
+		return opcode == OpCode::equal_int ? res : !res;
 	}
-}
 
-void Executor::executeIdentifiers(string& name) {
-	Identifier* ident = identifiersTable.getByName(name);
+	if (opcode == OpCode::less_int)
+		return v2 < v1;
 
-	if (ident != nullptr)
-		stack.push(Lexeme(ident));
-	else
-		throw string("Undefined identifier");
+	if (opcode == OpCode::less_equal_int)
+		return v2 <= v1;
+
+	if (opcode == OpCode::greater_int)
+		return v2 > v1;
+
+	return v2 >= v1;
 }
 
-void Executor::executeUnaryMinus() {
-	string& v = stack.top().getValue();
+// result of binary operation replaces second argument on the top of stack
+void Executor::executeIntAriphmetics(OpCode opcode) {
+	calculateInt(opcode, top(1).getInt(), top().getInt());
+	stackSize--;
+}
 
-	if (v.find(LEX_MINUS) == string::npos)
-		v = LEX_MINUS + v;
+void Executor::executeRealAriphmetics(OpCode opcode) {
+	LongDouble& v1 = top().getReal();
+	LongDouble& v2 = top(1).getReal();
+	stackSize--;
+
+	if (opcode == OpCode::add_real)
+		v2 = v2 + v1;
+	else if (opcode == OpCode::sub_real)
+		v2 = v2 - v1;
+	else if (opcode == OpCode::mult_real)
+		v2 = v2 * v1;
+	else if (v1 != 0)
+		v2 = v2 / v1;
 	else
-		v.erase(0, 1);
-
-	stack.top().setValue(v);
+		throw string("Division by zero");
 }
 
-void Executor::executeIncDec(int value) {
-	Identifier* ident = identifiersTable.getByName(stack.top().getValue());
-	stack.pop();
+void Executor::executeConcat() {
+	top(1).getString() += top().getString();
+	stackSize--;
+}
 
-	LongInt v = stringToInt(ident->getValue());
+void Executor::executeIntComparsions(OpCode opcode) {
+	bool res = compareInt(opcode, top(1), top());
 
-	ident->setValue(intToString(v + value));
+	stackSize--;
+	top() = Value(res);
 }
 
-void Executor::executeShortOp(string& lexV) {
-	Lexeme arg = stack.top();
-	stack.pop();
+void Executor::executeRealComparsions(OpCode opcode) {
+	Value& arg1 = top();
+	Value& arg2 = top(1);
+	stackSize--;
 
-	Identifier* ident = identifiersTable.getByName(stack.top().getValue());
-	IdentifierT type = ident->getType();
-	stack.pop();
+	LongDouble& v1 = arg1.getReal();
+	LongDouble& v2 = arg2.getReal();
+	bool res;
 
-	string result;
+	if (opcode == OpCode::equal_real)
+		res = v2 == v1;
+	else if (opcode == OpCode::nequal_real)
+		res = v2 != v1;
+	else if (opcode == OpCode::less_real)
+		res = v2 < v1;
+	else if (opcode == OpCode::less_equal_real)
+		res = v2 <= v1;
+	else if (opcode == OpCode::greater_real)
+		res = v2 > v1;
+	else
+		res = v2 >= v1;
 
-	if (type == IdentifierT::identifier_string) {
-		result = ident->getValue();
-		result += arg.getValue();
-	}
-	else if (type == IdentifierT::identifier_int) {
-		LongInt v1 = lexemeToInt(arg);
-		LongInt v2 = stringToInt(ident->getValue());
-		LongInt res;
-
-		if (lexV == LEX_PLUS)
-			res = v2 + v1;
-		else if (lexV == LEX_MINUS)
-			res = v2 - v1;
-		else if (lexV == LEX_MULT)
-			res = v2 * v1;
-		else if (v1 != 0)
-			res = (lexV == LEX_DIV) ? (v2 / v1) : (v2 % v1);
-		else
-			throw string("Division by zero");
-
-		result = intToString(res);
-	} else if (type == IdentifierT::identifier_real) {
-		LongDouble v1 = lexemeToReal(arg);
-		LongDouble v2 = stringToReal(ident->getValue());
-		LongDouble res;
-
-		if (lexV == LEX_PLUS)
-			res = v2 + v1;
-		else if (lexV == LEX_MINUS)
-			res = v2 - v1;
-		else if (lexV == LEX_MULT)
-			res = v2 * v1;
-		else if (v1 != 0)
-			res = v2 / v1;
-		else
-			throw string("Division by zero");
+	arg2 = Value(res);
+}
 
-		result = realToString(res);
-	}
+void Executor::executeStringComparsions(OpCode opcode) {
+	Value& arg1 = top();
+	Value& arg2 = top(1);
+	stackSize--;
+
+	string& v1 = arg1.getString();
+	string& v2 = arg2.getString();
+	bool res;
+
+	if (opcode == OpCode::equal_string)
+		res = v2 == v1;
+	else if (opcode == OpCode::nequal_string)
+		res = v2 != v1;
+	else if (opcode == OpCode::less_string)
+		res = v2 < v1;
 	else
-		throw "Unknown identifier type in short operation" + lexV;
+		res = v2 > v1;
 
-	ident->setValue(result);
+	arg2 = Value(res);
 }
 
-void Executor::executeNot() {
-	Lexeme& arg = stack.top();
+void Executor::executeCast(OpCode opcode) {
+	Value& arg = top();
 
-	arg.setValue(lexemeToBool(arg) ? LEX_FALSE : LEX_TRUE);
+	if (opcode == OpCode::int_to_real)
+		arg = Value(arg.toReal());
+	else if (opcode == OpCode::real_to_int)
+		arg = Value(Integer(arg.getReal()));
+	else
+		arg = Value(arg.toString());
 }
 
-void Executor::executeOr() {
-	Lexeme arg1 = stack.top();
-	stack.pop();
+void Executor::executeSlotConstInt(const Instruction& instruction) {
+	push(variables[instruction.slot]);
+
+	Value& left = top();
+	const Value& right = program->constants[instruction.constant];
 
-	Lexeme arg2 = stack.top();
-	stack.pop();
+	if (instruction.operation >= OpCode::equal_int)
+		left = Value(compareInt(instruction.operation, left, right));
+	else
+		calculateInt(instruction.operation, left.getInt(), right.getInt());
+}
 
-	stack.push(Lexeme(LexemeT::constant_boolean, (lexemeToBool(arg1) || lexemeToBool(arg2)) ? LEX_TRUE : LEX_FALSE));
+// returns true if jump is needed
+bool Executor::executeSlotConstIntFgo(const Instruction& instruction) {
+	return !compareInt(instruction.operation, variables[instruction.slot], program->constants[instruction.constant]);
 }
 
-void Executor::executeAnd() {
-	Lexeme arg1 = stack.top();
-	stack.pop();
+bool Executor::executeConstIntFgo(const Instruction& instruction) {
+	bool res = compareInt(instruction.operation, top(), program->constants[instruction.constant]);
+	stackSize--;
 
-	Lexeme arg2 = stack.top();
-	stack.pop();
+	return !res;
+}
 
-	stack.push(Lexeme(LexemeT::constant_boolean, (lexemeToBool(arg1) && lexemeToBool(arg2)) ? LEX_TRUE : LEX_FALSE));
+void Executor::executeGo(unsigned long& rpnIndex, int target) {
+	rpnIndex = target - 1;
 }
 
-void Executor::executeAriphmetics(string& lexV) {
-	Lexeme arg1 = stack.top();
-	stack.pop();
+void Executor::executeFgo(unsigned long& rpnIndex, int target) {
+	if (!top().getBool())
+		rpnIndex = target - 1;
 
-	Lexeme arg2 = stack.top();
-	stack.pop();
+	stackSize--;
+}
 
-	IdentifierT t1 = getLexemeType(arg1);
-	IdentifierT t2 = getLexemeType(arg2);	
+void Executor::executeRead(int slot) {
+	output.flush(); // prompt must be visible before input
 
-	if (t2 == IdentifierT::identifier_string) {
-		string& res = arg2.getValue();
-		res += arg1.getValue();
+	Value& ident = variables[slot];
+	IdentifierT identT = ident.getType();
 
-		stack.push(Lexeme(LexemeT::constant_string, res));
-	}
-	else if (t1 == IdentifierT::identifier_real || t2 == IdentifierT::identifier_real) {
-		LongDouble v1 = lexemeToReal(arg1);
-		LongDouble v2 = lexemeToReal(arg2);
-		LongDouble res;
-
-		if (lexV == LEX_PLUS)
-			res = v2 + v1;
-		else if (lexV == LEX_MINUS)
-			res = v2 - v1;
-		else if (lexV == LEX_MULT)
-			res = v2 * v1;
-		else if (v1 != 0)
-			res = v2 / v1;
-		else
-			throw string("Division by zero");
+	if (identT == IdentifierT::identifier_real)
+		ident = Value(input->readReal());
+	else if (identT == IdentifierT::identifier_int)
+		ident = Value(input->readInt());
+	else {
+		string s;
+		input->readLine(s);
 
-		stack.push(Lexeme(LexemeT::constant_real, realToString(res)));
-	}
-	else if (t2 == IdentifierT::identifier_int) {
-		LongInt v1 = lexemeToInt(arg1);
-		LongInt v2 = lexemeToInt(arg2);
-		LongInt res;
+		if (identT == IdentifierT::identifier_string)
+			ident = Value(s);
+		else {
+			transform(s.begin(), s.end(), s.begin(), ::tolower);
 
-		if (lexV == LEX_PLUS) {
-			res = v2 + v1;
-		}
-		else if (lexV == LEX_MINUS) {
-			res = v2 - v1;
+			ident = Value(s == LEX_TRUE);
 		}
-		else if (lexV == LEX_MULT) {
-			res = v2 * v1;
-		}
-		else if (v1 != 0) {
-			res = (lexV == LEX_DIV) ? (v2 / v1) : (v2 % v1);
-		}
-		else
-			throw string("Division by zero");
-
-		stack.push(Lexeme(LexemeT::constant_int, intToString(res)));
 	}
-	else
-		throw string("Unknown lexeme at ariphmetics process");
 }
 
-void Executor::executeEqualities(string& lexV) {
-	Lexeme arg1 = stack.top();
-	stack.pop();
+void Executor::executeWrite() {
+	output.write(top().toString());
+
+	stackSize--;
+}
+
+// value is already converted to type of identifier by syntax analyzer
+void Executor::executeAssign(int slot) {
+	variables[slot] = top();
+	stackSize--;
+}
 
-	Lexeme arg2 = stack.top();
-	stack.pop();
+void Executor::updateIdentifiersTable() {
+	for (auto i = identifiersTable.identifiers.begin(); i < identifiersTable.identifiers.end(); i++)
+		if (i->getSlot() >= 0)
+			i->setValue(variables[i->getSlot()]);
+}
 
-	IdentifierT t1 = getLexemeType(arg1);
-	IdentifierT t2 = getLexemeType(arg2);
+void Executor::printStackDump(unsigned long rpnIndex, const string& instruction) {
+	output.flush();
+	cout << endl << endl << ".====================================================================================================." << endl;
 
-	bool res;
+	printCenterCell(string("Stack (index: ") + to_string((signed long) rpnIndex) + ", current instruction: " + instruction + ")", 100, BOLDGREEN);
 
-	if ((t1 == IdentifierT::identifier_real || t1 == IdentifierT::identifier_int) &&
-		(t2 == IdentifierT::identifier_real || t2 == IdentifierT::identifier_int)) {
-		LongDouble v1 = lexemeToReal(arg1), v2 = lexemeToReal(arg2);
+	cout << "|----------------------------------------------------------------------------------------------------|" << endl;
 
-		res = (lexV == LEX_EQUAL) ? (v1 == v2) : (v1 != v2);
-	}
+	if (!stackSize)
+		printCenterCell("stack is empty", 100, BOLDRED);
 	else
-		res = (lexV == LEX_EQUAL) ? (arg1.getValue() == arg2.getValue()) : (arg1.getValue() != arg2.getValue());
+		for (size_t i = 0; i < stackSize; i++)
+			printCenterCell(Lexeme(top(i).toConstantLexemeT(), top(i).toString()).printForRPN(false), 100, BOLDYELLOW);
 
-	stack.push(Lexeme(LexemeT::constant_boolean, res ? LEX_TRUE : LEX_FALSE));
+	cout << "'===================================================================================================='" << endl;
 }
 
-void Executor::executeComparsions(string& lexV) {
-	Lexeme arg1 = stack.top();
-	stack.pop();
+ExecutionStats::ExecutionStats() {
+	this->instructions = 0;
+	this->peakStackSize = 0;
+	this->peakDigits = 0;
+	this->threaded = false;
+	this->blockStart = nullptr;
+	this->blockDepth = 0;
+}
 
-	Lexeme arg2 = stack.top();
-	stack.pop();
+// results of instructions are left on the top of stack or in variable
+void Executor::updateStats(ExecutionStats& stats, const Instruction& instruction) {
+	stats.instructions++;
+	stats.peakStackSize = max(stats.peakStackSize, stackSize);
 
-	bool res = false;
+	if (stackSize)
+		stats.peakDigits = max(stats.peakDigits, top().bignumDigits());
 
-	IdentifierT t1 = getLexemeType(arg1);
-	IdentifierT t2 = getLexemeType(arg2);	
+	int slot = instruction.isFused() ? instruction.slot : (instruction.hasSlot() ? instruction.arg : -1);
 
-	if (t1 == IdentifierT::identifier_real || t2 == IdentifierT::identifier_real) {
-		LongDouble v1 = lexemeToReal(arg1);
-		LongDouble v2 = lexemeToReal(arg2);
+	if (slot >= 0)
+		stats.peakDigits = max(stats.peakDigits, variables[slot].bignumDigits());
+}
 
-		if (lexV == LEX_LESS)
-			res = v2 < v1;
-		else if (lexV == LEX_LESS_EQUAL)
-			res = v2 <= v1;
-		else if (lexV == LEX_GREATER)
-			res = v2 > v1;
-		else
-			res = v2 >= v1;		
-	}
-	else if (t1 == IdentifierT::identifier_int) {
-		LongInt v1 = lexemeToInt(arg1);
-		LongInt v2 = lexemeToInt(arg2);
-
-		if (lexV == LEX_LESS)
-			res = v2 < v1;
-		else if (lexV == LEX_LESS_EQUAL)
-			res = v2 <= v1;
-		else if (lexV == LEX_GREATER)
-			res = v2 > v1;
-		else
-			res = v2 >= v1;
-	}
-	else if (t1 == IdentifierT::identifier_string) {
-		if (lexV == LEX_LESS)
-			res = lexemeToString(arg2) < lexemeToString(arg1);
-		else
-			res = lexemeToString(arg2) > lexemeToString(arg1);
-	}
+// every jump ends a block, so stack growth inside of block is known before execution
+void Executor::startBlockStats(ExecutionStats& stats) {
+	const Instruction* code = program->getCode();
+	size_t size = program->size();
 
-	stack.push(Lexeme(LexemeT::constant_boolean, res ? LEX_TRUE : LEX_FALSE));
-}
+	stats.threaded = true;
+	stats.blockPeaks.assign(size + 1, 0);
+	stats.nextWrites.assign(size + 1, size);
 
-void Executor::executeGo(unsigned long& rpnIndex) {
-	rpnIndex = stoi(stack.top().getValue()) - 1;
-	stack.pop();
-}
+	for (size_t i = size; i > 0; i--) {
+		const Instruction& instruction = code[i - 1];
+		long growth = instruction.stackEffect();
 
-void Executor::executeFgo(unsigned long& rpnIndex) {
-	LongInt i = lexemeToInt(stack.top());
-	stack.pop();
+		if (!instruction.isJump() && instruction.opcode != OpCode::halt)
+			growth += stats.blockPeaks[i];
 
-	Lexeme arg2 = stack.top();
-	stack.pop();
+		stats.blockPeaks[i - 1] = max(0L, growth);
+		stats.nextWrites[i - 1] = instruction.writtenSlot() >= 0 ? i - 1 : stats.nextWrites[i];
+	}
 
-	if (!lexemeToBool(arg2))
-		rpnIndex = stoi(i.toString()) - 1;
+	stats.blockStart = code;
+	stats.blockDepth = stackSize;
 }
 
-void Executor::executeRead() {
-	Identifier* ident = identifiersTable.getByName(stack.top().getValue());
-	IdentifierT identT = ident->getType();
-	stack.pop();
+// block from stats.blockStart to end (including it) is executed, next block starts at next
+void Executor::updateBlockStats(ExecutionStats& stats, const Instruction* end, const Instruction* next) {
+	stats.instructions += end - stats.blockStart + 1;
+	stats.peakStackSize = max(stats.peakStackSize, stats.blockDepth + stats.blockPeaks[stats.blockStart - program->getCode()]);
 
-	if (identT == IdentifierT::identifier_real) {
-		long double x;
-		cin >> x;
-		LongDouble r(x);
-		cin.ignore(); // skip '\n' character
+	sampleBlockDigits(stats, end + 1);
 
-		ident->setValue(realToString(r));
-	}
-	else if (identT == IdentifierT::identifier_int) {
-		LongInt k;
-		cin >> k;
-		cin.ignore(); // skip '\n' character
+	stats.blockStart = next;
+	stats.blockDepth = stackSize;
+}
 
-		ident->setValue(intToString(k));
-	}
-	else if (identT == IdentifierT::identifier_string) {
-		string s;
-		getline(cin, s);
+// instructions of current block before failed one are executed
+void Executor::updateFailedBlockStats(ExecutionStats& stats, const Instruction* failed) {
+	long depth = stats.blockDepth;
 
-		ident->setValue(s);
+	for (const Instruction* instruction = stats.blockStart; instruction < failed; instruction++) {
+		depth += instruction->stackEffect();
+		stats.peakStackSize = max(stats.peakStackSize, (size_t) depth);
 	}
-	else {
-		string s;
-		getline(cin, s);
 
-		transform(s.begin(), s.end(), s.begin(), ::tolower);
+	stats.instructions += failed - stats.blockStart;
 
-		ident->setValue(s == LEX_TRUE ? LEX_TRUE : LEX_FALSE);
-	}
+	sampleBlockDigits(stats, failed);
 }
 
-void Executor::executeWrite() {
-	cout << stack.top().getValue();
+// only variables changed by instructions of block before end are sampled, so cost doesn't depend on number of variables
+void Executor::sampleBlockDigits(ExecutionStats& stats, const Instruction* end) {
+	const Instruction* code = program->getCode();
+	size_t last = end - code;
 
-	stack.pop();
+	if (stackSize)
+		stats.peakDigits = max(stats.peakDigits, top().bignumDigits());
+
+	for (size_t i = stats.nextWrites[stats.blockStart - code]; i < last; i = stats.nextWrites[i + 1])
+		stats.peakDigits = max(stats.peakDigits, variables[code[i].writtenSlot()].bignumDigits());
 }
 
-void Executor::executeAssign() {
-	Lexeme arg1 = stack.top();
-	stack.pop();	
+void Executor::executeSwitch(int printStack, Profiler* profiler, ExecutionStats* stats) {
+	unsigned long rpnIndex = 0;
+	unsigned long size = program->size();
+	const Instruction* code = program->getCode();
+
+	while (rpnIndex < size) {
+		const Instruction& instruction = code[rpnIndex];
+
+		if (profiler)
+			profiler->step(instruction.line);
+
+#ifdef OPCODE_STATS
+		chrono::steady_clock::time_point instructionStart = chrono::steady_clock::now();
+#endif
+
+		switch (instruction.opcode) {
+			case OpCode::push:
+				push(program->constants[instruction.arg]);
+				break;
+
+			case OpCode::load:
+				executeIdentifiers(instruction.arg);
+				break;
+
+			case OpCode::minus_int:
+				executeIntMinus();
+				break;
+
+			case OpCode::minus_real:
+				executeRealMinus();
+				break;
+
+			case OpCode::add_value_int:
+			case OpCode::sub_value_int:
+			case OpCode::mult_value_int:
+			case OpCode::div_value_int:
+				executeIntShortOp(instruction.opcode, instruction.arg);
+				break;
+
+			case OpCode::add_value_real:
+			case OpCode::sub_value_real:
+			case OpCode::mult_value_real:
+			case OpCode::div_value_real:
+				executeRealShortOp(instruction.opcode, instruction.arg);
+				break;
+
+			case OpCode::concat_value:
+				executeConcatValue(instruction.arg);
+				break;
+
+			case OpCode::increment:
+				executeIncDec(instruction.arg, 1);
+				break;
+
+			case OpCode::decrement:
+				executeIncDec(instruction.arg, -1);
+				break;
+
+			case OpCode::logic_not:
+				executeNot();
+				break;
+
+			case OpCode::write:
+				executeWrite();
+				break;
+
+			case OpCode::read:
+				executeRead(instruction.arg);
+				break;
+
+			case OpCode::add_int:
+			case OpCode::sub_int:
+			case OpCode::mult_int:
+			case OpCode::div_int:
+			case OpCode::mod_int:
+				executeIntAriphmetics(instruction.opcode);
+				break;
+
+			case OpCode::add_real:
+			case OpCode::sub_real:
+			case OpCode::mult_real:
+			case OpCode::div_real:
+				executeRealAriphmetics(instruction.opcode);
+				break;
+
+			case OpCode::concat:
+				executeConcat();
+				break;
+
+			case OpCode::equal_int:
+			case OpCode::nequal_int:
+			case OpCode::less_int:
+			case OpCode::greater_int:
+			case OpCode::less_equal_int:
+			case OpCode::greater_equal_int:
+				executeIntComparsions(instruction.opcode);
+				break;
+
+			case OpCode::equal_real:
+			case OpCode::nequal_real:
+			case OpCode::less_real:
+			case OpCode::greater_real:
+			case OpCode::less_equal_real:
+			case OpCode::greater_equal_real:
+				executeRealComparsions(instruction.opcode);
+				break;
+
+			case OpCode::equal_string:
+			case OpCode::nequal_string:
+			case OpCode::less_string:
+			case OpCode::greater_string:
+				executeStringComparsions(instruction.opcode);
+				break;
+
+			case OpCode::int_to_real:
+			case OpCode::real_to_int:
+			case OpCode::int_to_string:
+			case OpCode::real_to_string:
+				executeCast(instruction.opcode);
+				break;
+
+			case OpCode::assign:
+				executeAssign(instruction.arg);
+				break;
+
+			case OpCode::fgo:
+				executeFgo(rpnIndex, instruction.arg);
+				break;
+
+			case OpCode::go:
+				executeGo(rpnIndex, instruction.arg);
+				break;
+
+			case OpCode::slot_const_int:
+				executeSlotConstInt(instruction);
+				break;
+
+			case OpCode::slot_const_int_fgo:
+				if (executeSlotConstIntFgo(instruction))
+					executeGo(rpnIndex, instruction.arg);
+				break;
+
+			case OpCode::const_int_fgo:
+				if (executeConstIntFgo(instruction))
+					executeGo(rpnIndex, instruction.arg);
+				break;
+
+			case OpCode::inc_go:
+				executeIncDec(instruction.slot, 1);
+				executeGo(rpnIndex, instruction.arg);
+				break;
+
+			case OpCode::halt:
+				return;
+
+			default:
+				break;
+		}
+
+#ifdef OPCODE_STATS
+		opcodeStats.add(instruction, chrono::steady_clock::now() - instructionStart);
+#endif
+
+		if (stats)
+			updateStats(*stats, instruction);
 
-	Identifier* ident = identifiersTable.getByName(stack.top().getValue());
-	IdentifierT identT = ident->getType();
-	stack.pop();
+		if (printStack) {
+			printStackDump(rpnIndex, program->printInstruction(rpnIndex, false));
+			updateIdentifiersTable();
+			cout << endl << identifiersTable << endl;
 
-	if (identT == IdentifierT::identifier_int && getLexemeType(arg1) == IdentifierT::identifier_real) {
-		ident->setValue(lexemeToReal(arg1).intToString());
+			if (printStack > 1) {
+				cout << BOLDCYAN << "Press enter for next step" << RESET;
+				getchar();
+			}
+		}
+
+		rpnIndex++;
 	}
-	else
-		ident->setValue(arg1.getValue());
 }
 
-void Executor::printStackDump(unsigned long rpnIndex, const string& lexV) {
-	std::stack<Lexeme> dump = stack;
+#ifdef THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+#define DISPATCH() goto *handlers[(size_t) instruction->opcode]
+#define NEXT() instruction++; DISPATCH()
+#define JUMP(target) if (stats) updateBlockStats(*stats, instruction, code + (target)); instruction = code + (target); DISPATCH()
+#define NO_JUMP() if (stats) updateBlockStats(*stats, instruction, instruction + 1); NEXT()
+
+// direct threaded dispatch: every handler jumps straight to the handler of the next instruction
+// stats are updated only at jumps, so counting doesn't change dispatch of other instructions
+void Executor::executeThreaded(ExecutionStats* stats) {
+	static void* handlers[] = {
+		&&op_nop,
+		&&op_push,
+		&&op_load,
+		&&op_minus_int,
+		&&op_minus_real,
+		&&op_increment,
+		&&op_decrement,
+		&&op_add_value_int,
+		&&op_sub_value_int,
+		&&op_mult_value_int,
+		&&op_div_value_int,
+		&&op_add_value_real,
+		&&op_sub_value_real,
+		&&op_mult_value_real,
+		&&op_div_value_real,
+		&&op_concat_value,
+		&&op_logic_not,
+		&&op_add_int,
+		&&op_sub_int,
+		&&op_mult_int,
+		&&op_div_int,
+		&&op_mod_int,
+		&&op_add_real,
+		&&op_sub_real,
+		&&op_mult_real,
+		&&op_div_real,
+		&&op_concat,
+		&&op_equal_int,
+		&&op_nequal_int,
+		&&op_less_int,
+		&&op_greater_int,
+		&&op_less_equal_int,
+		&&op_greater_equal_int,
+		&&op_equal_real,
+		&&op_nequal_real,
+		&&op_less_real,
+		&&op_greater_real,
+		&&op_less_equal_real,
+		&&op_greater_equal_real,
+		&&op_equal_string,
+		&&op_nequal_string,
+		&&op_less_string,
+		&&op_greater_string,
+		&&op_int_to_real,
+		&&op_real_to_int,
+		&&op_int_to_string,
+		&&op_real_to_string,
+		&&op_assign,
+		&&op_read,
+		&&op_write,
+		&&op_go,
+		&&op_fgo,
+		&&op_slot_const_int,
+		&&op_slot_const_int_fgo,
+		&&op_const_int_fgo,
+		&&op_inc_go,
+		&&op_halt
+	};
+
+	static_assert(sizeof(handlers) / sizeof(handlers[0]) == (size_t) OpCode::halt + 1, "handlers must match OpCode values");
+
+	const Instruction* code = program->getCode();
+	const Instruction* instruction = code;
+
+	if (stats)
+		startBlockStats(*stats);
 
-	cout << endl << endl << ".====================================================================================================." << endl;
+	try {
+		DISPATCH();
+
+	op_nop:
+		NEXT();
+
+	op_push:
+		push(program->constants[instruction->arg]);
+		NEXT();
+
+	op_load:
+		executeIdentifiers(instruction->arg);
+		NEXT();
+
+	op_minus_int:
+		executeIntMinus();
+		NEXT();
+
+	op_minus_real:
+		executeRealMinus();
+		NEXT();
+
+	op_increment:
+		executeIncDec(instruction->arg, 1);
+		NEXT();
+
+	op_decrement:
+		executeIncDec(instruction->arg, -1);
+		NEXT();
+
+	op_add_value_int:
+	op_sub_value_int:
+	op_mult_value_int:
+	op_div_value_int:
+		executeIntShortOp(instruction->opcode, instruction->arg);
+		NEXT();
+
+	op_add_value_real:
+	op_sub_value_real:
+	op_mult_value_real:
+	op_div_value_real:
+		executeRealShortOp(instruction->opcode, instruction->arg);
+		NEXT();
+
+	op_concat_value:
+		executeConcatValue(instruction->arg);
+		NEXT();
+
+	op_logic_not:
+		executeNot();
+		NEXT();
+
+	op_add_int:
+	op_sub_int:
+	op_mult_int:
+	op_div_int:
+	op_mod_int:
+		executeIntAriphmetics(instruction->opcode);
+		NEXT();
+
+	op_add_real:
+	op_sub_real:
+	op_mult_real:
+	op_div_real:
+		executeRealAriphmetics(instruction->opcode);
+		NEXT();
+
+	op_concat:
+		executeConcat();
+		NEXT();
+
+	op_equal_int:
+	op_nequal_int:
+	op_less_int:
+	op_greater_int:
+	op_less_equal_int:
+	op_greater_equal_int:
+		executeIntComparsions(instruction->opcode);
+		NEXT();
+
+	op_equal_real:
+	op_nequal_real:
+	op_less_real:
+	op_greater_real:
+	op_less_equal_real:
+	op_greater_equal_real:
+		executeRealComparsions(instruction->opcode);
+		NEXT();
+
+	op_equal_string:
+	op_nequal_string:
+	op_less_string:
+	op_greater_string:
+		executeStringComparsions(instruction->opcode);
+		NEXT();
+
+	op_int_to_real:
+	op_real_to_int:
+	op_int_to_string:
+	op_real_to_string:
+		executeCast(instruction->opcode);
+		NEXT();
+
+	op_assign:
+		executeAssign(instruction->arg);
+		NEXT();
+
+	op_read:
+		executeRead(instruction->arg);
+		NEXT();
+
+	op_write:
+		executeWrite();
+		NEXT();
+
+	op_go:
+		JUMP(instruction->arg);
+
+	op_fgo:
+		if (!top().getBool()) {
+			stackSize--;
+			JUMP(instruction->arg);
+		}
 
-	printCenterCell(string("Stack (index: ") + to_string((signed long) rpnIndex) + ", current lexeme: " + lexV + ")", 100, BOLDGREEN);
+		stackSize--;
+		NO_JUMP();
 
-	cout << "|----------------------------------------------------------------------------------------------------|" << endl;
+	op_slot_const_int:
+		executeSlotConstInt(*instruction);
+		NEXT();
 
-	if (dump.empty())
-		printCenterCell("stack is empty", 100, BOLDRED);
-	else
-		while (!dump.empty()) {
-			printCenterCell(dump.top().printForRPN(false), 100, BOLDYELLOW);
+	op_slot_const_int_fgo:
+		if (executeSlotConstIntFgo(*instruction)) {
+			JUMP(instruction->arg);
+		}
+
+		NO_JUMP();
 
-			dump.pop();
+	op_const_int_fgo:
+		if (executeConstIntFgo(*instruction)) {
+			JUMP(instruction->arg);
 		}
 
-	cout << "'===================================================================================================='" << endl;
+		NO_JUMP();
+
+	op_inc_go:
+		executeIncDec(instruction->slot, 1);
+		JUMP(instruction->arg);
+
+	op_halt:
+		if (stats) {
+			updateBlockStats(*stats, instruction, instruction);
+			stats->instructions--; // halt isn't counted as in switch loop
+		}
+	}
+	catch (...) {
+		if (stats)
+			updateFailedBlockStats(*stats, instruction);
+
+		throw;
+	}
 }
 
-void Executor::execute(int printStack) {
-	try {
-		unsigned long rpnIndex = 0;
-		unsigned long size = rpn.size();
-
-		while (rpnIndex < size) {
-			Lexeme& lex = rpn[rpnIndex];
-			string& lexV = lex.getValue();
-
-			switch (lex.getType()) {
-				case LexemeT::constant_int:
-				case LexemeT::constant_real:
-				case LexemeT::constant_string:
-				case LexemeT::constant_boolean:
-				case LexemeT::rpn_address:
-				case LexemeT::rpn_label:
-					stack.push(lex);
-					break;
-
-				case LexemeT::identifier:
-					executeIdentifiers(lexV);
-					break;
-
-				case LexemeT::rpn_minus:
-					executeUnaryMinus();
-					break;
-
-				case LexemeT::rpn_short_op:
-					executeShortOp(lexV);
-					break;
-
-				case LexemeT::rpn_increment:
-					executeIncDec(1);
-					break;
-
-				case LexemeT::rpn_decrement:
-					executeIncDec(-1);
-					break;
-
-				case LexemeT::keyword:
-					if (lexV == LEX_NOT)
-						executeNot();
-					else if (lexV == LEX_OR)
-						executeOr();
-					else if (lexV == LEX_AND)
-						executeAnd();
-					else if (lexV == LEX_WRITE)
-						executeWrite();
-					else if (lexV == LEX_READ)
-						executeRead();
-					break;
-
-				case LexemeT::delimeter:
-					if (lex.isAriphmeticOp())
-						executeAriphmetics(lexV);
-					else if (lexV == LEX_EQUAL || lexV == LEX_NEQUAL)
-						executeEqualities(lexV);
-					else if (lexV == LEX_LESS || lexV == LEX_GREATER || lexV == LEX_LESS_EQUAL || lexV == LEX_GREATER_EQUAL)
-						executeComparsions(lexV);
-					else if (lexV == LEX_EQUALS)
-						executeAssign();					
-					break;
-
-				case LexemeT::rpn_fgo:
-					executeFgo(rpnIndex);					
-					break;
-
-				case LexemeT::rpn_go:
-					executeGo(rpnIndex);
-					break;
-
-				default:
-					break;
-			}
+#undef DISPATCH
+#undef NEXT
+#undef JUMP
+#undef NO_JUMP
 
-			if (printStack) {
-				printStackDump(rpnIndex, lex.printForRPN(false));
-				cout << endl << identifiersTable << endl;
+#pragma GCC diagnostic pop
+#endif
 
-				if (printStack > 1) {
-					cout << BOLDCYAN << "Press enter for next step" << RESET;
-					getchar();
-				}
-			}
+void Executor::executeProgram(int printStack, Profiler* profiler, ExecutionStats* stats) {
+// instructions can be timed only one by one in switch loop
+#if defined(THREADED_DISPATCH) && !defined(OPCODE_STATS)
+	if (!printStack && !profiler)
+		executeThreaded(stats);
+	else
+		executeSwitch(printStack, profiler, stats);
+#else
+	executeSwitch(printStack, profiler, stats);
+#endif
+}
 
-			rpnIndex++;
-		}
+void Executor::setIO(const InputReader& reader, const OutputWriter& writer) {
+	input->setReader(reader);
+	output.setWriter(writer);
+}
+
+void Executor::setInput(InputBuffer& input) {
+	this->input = &input;
+}
+
+void Executor::execute(int printStack, Profiler* profiler, ExecutionStats* stats) {
+	if (profiler)
+		profiler->start();
+
+#ifdef OPCODE_STATS
+	chrono::steady_clock::time_point runStart = chrono::steady_clock::now();
+#endif
+
+	try {
+		executeProgram(printStack, profiler, stats);
 	}
 	catch (string e) {
+		output.flush();
 		cout << BOLDRED << "Execution error: " << e << RESET << endl;
 	}
-}
\ No newline at end of file
+
+	output.flush();
+
+	if (profiler)
+		profiler->stop();
+
+#ifdef OPCODE_STATS
+	opcodeStats.setRunTime(chrono::steady_clock::now() - runStart);
+	opcodeStats.printJSON(stderr);
+#endif
+}
+
+// output written before error is flushed, error is thrown to caller
+void Executor::run() {
+	try {
+		executeProgram(0, nullptr, nullptr);
+	}
+	catch (string e) {
+		output.flush();
+		throw;
+	}
+
+	output.flush();
+}
+
+// errors are not handled, result is the value left on the top of stack
+Value Executor::evaluate() {
+	executeSwitch(0);
+
+	if (!stackSize)
+		throw string("Expected value on the top of stack");
+
+	return top();
+}
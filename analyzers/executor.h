@@ -4,7 +4,6 @@
 #include <sstream>
 #include <string>
 #include <vector>
-#include <stack>
 #include <algorithm>
 
 #include "../enums.h"
@@ -13,53 +12,113 @@
 #include "../entities/lexeme.h"
 #include "../entities/identifier.h"
 #include "../entities/identifiersTable.h"
+#include "../entities/instruction.h"
+#include "../entities/program.h"
+#include "../entities/value.h"
+#include "../entities/outputBuffer.h"
+#include "../entities/inputBuffer.h"
+#include "../entities/profiler.h"
+
+#ifdef OPCODE_STATS
+#include "../entities/opcodeStats.h"
+#endif
 
 #include "../ariphmetics/LongInt.h"
 #include "../ariphmetics/LongDouble.h"
 
+// counters of execution, collected after every instruction in switch loop
+// or after every straight-line block in threaded dispatch (peak of digits is sampled at the ends of blocks
+// from top of operand stack and variables changed in block)
+class ExecutionStats {
+public:
+	unsigned long long instructions; // executed instructions
+	size_t peakStackSize; // maximum depth of operand stack
+	size_t peakDigits; // maximum length of LongInt or LongDouble value
+	bool threaded; // collected in threaded dispatch
+
+	std::vector<size_t> blockPeaks; // maximum growth of operand stack in block from instruction to the next jump
+	std::vector<size_t> nextWrites; // index of the nearest instruction from this one, which changes variable
+	const Instruction* blockStart; // first instruction of current block
+	size_t blockDepth; // depth of operand stack at the start of current block
+
+	ExecutionStats();
+};
+
 class Executor {
 	IdentifiersTable identifiersTable;
-	std::vector<Lexeme> rpn; // reverse polish notation
-	std::stack<Lexeme> stack;
-
-	std::string realToString(LongDouble v) const;
-	std::string intToString(LongInt v) const;
-	LongDouble stringToReal(const std::string& v) const;
-	LongInt stringToInt(const std::string& v) const;
+	const Program* program; // isn't copied: instructions of mapped image are used in place
+	std::vector<Value> variables; // values of identifiers by slot
+	std::vector<Value> stack; // operand stack preallocated for maximum depth of program
+	size_t stackSize;
+	OutputBuffer output; // buffer of write operator
+	InputBuffer ownInput; // buffer of read operator, if other isn't set by setInput
+	InputBuffer* input;
 
-	LongInt lexemeToInt(Lexeme& lexeme);
-	LongDouble lexemeToReal(Lexeme& lexeme);
-	bool lexemeToBool(Lexeme& lexeme);
-	std::string lexemeToString(Lexeme& lexeme);
+#ifdef OPCODE_STATS
+	OpcodeStats opcodeStats;
+#endif
 
-	IdentifierT getLexemeType(Lexeme& lexeme);
+	void push(const Value& value);
+	Value& top(size_t depth = 0);
 
 	// execute functions
-	void executeIdentifiers(std::string& name);
-	void executeUnaryMinus();
-	void executeIncDec(int value);
-	void executeShortOp(std::string& lexV);
+	void executeIdentifiers(int slot);
+	void executeIntMinus();
+	void executeRealMinus();
+	void executeIncDec(int slot, int value);
+	void executeIntShortOp(OpCode opcode, int slot);
+	void executeRealShortOp(OpCode opcode, int slot);
+	void executeConcatValue(int slot);
 
 	void executeNot();
-	void executeOr();
-	void executeAnd();
 
-	void executeAriphmetics(std::string& lexV);
-	void executeEqualities(std::string& lexV);
-	void executeComparsions(std::string& lexV);
+	void calculateInt(OpCode opcode, Integer& left, const Integer& right);
+	bool compareInt(OpCode opcode, const Value& left, const Value& right);
 
-	void executeGo(unsigned long& rpnIndex);
-	void executeFgo(unsigned long& rpnIndex);
+	void executeIntAriphmetics(OpCode opcode);
+	void executeRealAriphmetics(OpCode opcode);
+	void executeConcat();
 
-	void executeRead();
+	void executeIntComparsions(OpCode opcode);
+	void executeRealComparsions(OpCode opcode);
+	void executeStringComparsions(OpCode opcode);
+
+	void executeCast(OpCode opcode);
+
+	void executeSlotConstInt(const Instruction& instruction);
+	bool executeSlotConstIntFgo(const Instruction& instruction);
+	bool executeConstIntFgo(const Instruction& instruction);
+
+	void executeGo(unsigned long& rpnIndex, int target);
+	void executeFgo(unsigned long& rpnIndex, int target);
+
+	void executeRead(int slot);
 	void executeWrite();
-	void executeAssign();
+	void executeAssign(int slot);
 
-	void printStackDump(unsigned long rpnIndex, const std::string& lexV);
+	void updateIdentifiersTable();
+	void printStackDump(unsigned long rpnIndex, const std::string& instruction);
+
+	void updateStats(ExecutionStats& stats, const Instruction& instruction);
+	void startBlockStats(ExecutionStats& stats);
+	void updateBlockStats(ExecutionStats& stats, const Instruction* end, const Instruction* next);
+	void updateFailedBlockStats(ExecutionStats& stats, const Instruction* failed);
+	void sampleBlockDigits(ExecutionStats& stats, const Instruction* end);
+
+	void executeSwitch(int printStack, Profiler* profiler = nullptr, ExecutionStats* stats = nullptr);
+#ifdef THREADED_DISPATCH
+	void executeThreaded(ExecutionStats* stats);
+#endif
+	void executeProgram(int printStack, Profiler* profiler, ExecutionStats* stats);
 
 public:
-	Executor(IdentifiersTable& identifiersTable, std::vector<Lexeme>& rpn);
-	void execute(int printStack);
+	Executor(const IdentifiersTable& identifiersTable, const Program& program, size_t bufferSize = 65536, bool lineBuffered = false);
+	void execute(int printStack, Profiler* profiler = nullptr, ExecutionStats* stats = nullptr); // with profiler program is executed without threaded dispatch
+	void setIO(const InputReader& reader, const OutputWriter& writer);
+	void setInput(InputBuffer& input); // buffer shared by several executors, input read ahead by one of them is left for next ones
+
+	void run(); // errors aren't printed, but thrown
+	Value evaluate();
 };
 
 #endif
\ No newline at end of file
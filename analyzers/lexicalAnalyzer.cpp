@@ -45,7 +45,7 @@ void LexicalAnalyzer::checkSource(string& source) {
 
 			if (!source[i]) {
 				source.erase(i--, 1);
-				cout << BOLDYELLOW << "Warning: surpressed zero byte in text at line " << line << " (was deleted for interpreting)" << RESET << endl;
+				warnings.push_back("Warning: surpressed zero byte in text at line " + to_string(line) + " (was deleted for interpreting)");
 			}
 		}
 
@@ -341,6 +341,15 @@ vector<string>& LexicalAnalyzer::getTextLines() {
 	return lines;
 }
 
+const vector<string>& LexicalAnalyzer::getWarnings() const {
+	return warnings;
+}
+
+void LexicalAnalyzer::printWarnings() const {
+	for (size_t i = 0; i < warnings.size(); i++)
+		cout << BOLDYELLOW << warnings[i] << RESET << endl;
+}
+
 void LexicalAnalyzer::printText() const {
 	cout << BOLDMAGENTA << "Program text: " << RESET << endl;
 	cout << BLUE;
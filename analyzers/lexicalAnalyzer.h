@@ -19,6 +19,7 @@ class LexicalAnalyzer {
 	IdentifiersTable identifiersTable;
 	std::vector<Lexeme> lexemes;
 	std::vector<std::string> lines;
+	std::vector<std::string> warnings; // problems of source text, which don't stop interpreting
 
 	Lexeme getLexem();
 
@@ -48,6 +49,9 @@ public:
 	std::vector<std::string>& getTextLines();
 	std::vector<Lexeme>& analyze();
 	IdentifiersTable& getIdentifiersTable();
+	const std::vector<std::string>& getWarnings() const;
+
+	void printWarnings() const;
 
 	void printText() const;
 	void printLexemes() const;
@@ -0,0 +1,252 @@
+#include "optimizer.h"
+
+using namespace std;
+
+Optimizer::Optimizer(vector<Lexeme>& rpn) {
+	this->rpn = rpn;
+	this->foldedCount = 0;
+	this->removedCount = 0;
+}
+
+// lexemes which can be reached not only from previous lexeme
+vector<bool> Optimizer::jumpTargets() const {
+	vector<bool> targets(rpn.size() + 1, false);
+
+	for (size_t i = 0; i < rpn.size(); i++)
+		if (rpn[i].getType() == LexemeT::rpn_label)
+			targets[stoul(rpn[i].getValue())] = true;
+
+	return targets;
+}
+
+// positions contains new index of every lexeme of rpn (and of the end of rpn)
+void Optimizer::remapLabels(vector<Lexeme>& code, const vector<unsigned long>& positions) const {
+	for (size_t i = 0; i < code.size(); i++)
+		if (code[i].getType() == LexemeT::rpn_label)
+			code[i].setValue(to_string(positions[stoul(code[i].getValue())]));
+}
+
+// removes lexemes which are not kept, jumps to removed lexeme lead to the next kept one
+size_t Optimizer::compact(const vector<bool>& keep) {
+	vector<unsigned long> positions;
+	vector<Lexeme> code;
+	size_t removed = 0;
+
+	for (size_t i = 0; i < rpn.size(); i++) {
+		positions.push_back(code.size());
+
+		if (keep[i])
+			code.push_back(rpn[i]);
+		else if (rpn[i].getType() != LexemeT::rpn_label && rpn[i].getType() != LexemeT::rpn_address)
+			removed++; // labels and addresses are not compiled to instructions
+	}
+
+	positions.push_back(code.size());
+	remapLabels(code, positions);
+
+	rpn = code;
+
+	return removed;
+}
+
+// number of constant operands needed to evaluate lexeme at compile time (0 if lexeme can't be evaluated)
+int Optimizer::foldArity(const Lexeme& lexeme) const {
+	const string& lexV = lexeme.getValue();
+
+	switch (lexeme.getType()) {
+		case LexemeT::rpn_minus:
+		case LexemeT::rpn_cast:
+			return 1;
+
+		case LexemeT::keyword:
+			return lexV == LEX_NOT ? 1 : 0;
+
+		case LexemeT::delimeter:
+			return lexeme.isAriphmeticOp() || lexeme.isComparison() ? 2 : 0;
+
+		default:
+			return 0;
+	}
+}
+
+// expression is compiled and executed exactly as it would be at run time
+bool Optimizer::evaluate(vector<Lexeme>& expression, Lexeme& result) const {
+	try {
+		IdentifiersTable identifiersTable;
+		Compiler compiler(identifiersTable, expression);
+		Executor executor(identifiersTable, compiler.compile());
+
+		Value value = executor.evaluate();
+
+		// generated lexemes (casts, short operations) have line 0, so line is taken from the first source lexeme
+		unsigned long line = 0;
+
+		for (size_t i = 0; i < expression.size() && !line; i++)
+			line = expression[i].getLineNumber();
+
+		result = Lexeme(value.toConstantLexemeT(), value.toString(), line);
+	}
+	catch (string e) { // e.g. division by zero, error will be reported at run time
+		return false;
+	}
+
+	return true;
+}
+
+void Optimizer::foldConstants() {
+	vector<bool> targets = jumpTargets();
+	vector<unsigned long> positions;
+	vector<Lexeme> code;
+	int constants = 0; // number of constants on the top of code which are always executed one after another
+
+	for (size_t i = 0; i < rpn.size(); i++) {
+		positions.push_back(code.size());
+
+		if (targets[i])
+			constants = 0;
+
+		if (rpn[i].isConstant()) {
+			code.push_back(rpn[i]);
+			constants++;
+
+			continue;
+		}
+
+		int arity = foldArity(rpn[i]);
+
+		if (arity && constants >= arity) {
+			vector<Lexeme> expression(code.end() - arity, code.end());
+			expression.push_back(rpn[i]);
+
+			Lexeme result;
+
+			if (evaluate(expression, result)) {
+				code.erase(code.end() - arity, code.end());
+				code.push_back(result);
+				constants -= arity - 1;
+				foldedCount++;
+
+				continue;
+			}
+		}
+
+		code.push_back(rpn[i]);
+		constants = 0;
+	}
+
+	positions.push_back(code.size());
+	remapLabels(code, positions);
+
+	rpn = code;
+}
+
+// jump to unconditional jump leads directly to the target of last one,
+// jump to fgo after boolean constant (as in short-circuit 'and' and 'or') leads to where fgo goes
+void Optimizer::threadJumps() {
+	for (size_t i = 0; i < rpn.size(); i++) {
+		if (rpn[i].getType() != LexemeT::rpn_label)
+			continue;
+
+		unsigned long target = stoul(rpn[i].getValue());
+
+		for (size_t steps = 0; steps < rpn.size() && target + 1 < rpn.size(); steps++) {
+			if (rpn[target].getType() == LexemeT::rpn_label && rpn[target + 1].getType() == LexemeT::rpn_go)
+				target = stoul(rpn[target].getValue());
+			else if (rpn[target].getType() == LexemeT::constant_boolean && target + 2 < rpn.size() && rpn[target + 2].getType() == LexemeT::rpn_fgo)
+				target = rpn[target].getValue() == LEX_TRUE ? target + 3 : stoul(rpn[target + 1].getValue());
+			else
+				break;
+		}
+
+		rpn[i].setValue(to_string(target));
+	}
+}
+
+// fgo after boolean constant is removed (true) or replaced by go (false)
+vector<bool> Optimizer::foldBranches() {
+	vector<bool> targets = jumpTargets();
+	vector<bool> keep(rpn.size(), true);
+
+	for (size_t i = 2; i < rpn.size(); i++) {
+		if (rpn[i].getType() != LexemeT::rpn_fgo || rpn[i - 2].getType() != LexemeT::constant_boolean || targets[i - 1] || targets[i])
+			continue;
+
+		keep[i - 2] = false;
+
+		if (rpn[i - 2].getValue() == LEX_TRUE)
+			keep[i - 1] = keep[i] = false;
+		else
+			rpn[i].setType(LexemeT::rpn_go);
+	}
+
+	return keep;
+}
+
+vector<bool> Optimizer::markReachable() const {
+	vector<bool> reached(rpn.size() + 1, false);
+	vector<size_t> indexes(1, 0);
+
+	while (!indexes.empty()) {
+		size_t index = indexes.back();
+		indexes.pop_back();
+
+		if (reached[index])
+			continue;
+
+		reached[index] = true;
+
+		if (index == rpn.size())
+			continue;
+
+		LexemeT lexT = rpn[index].getType();
+
+		if (lexT == LexemeT::rpn_go || lexT == LexemeT::rpn_fgo)
+			indexes.push_back(stoul(rpn[index - 1].getValue()));
+
+		if (lexT != LexemeT::rpn_go)
+			indexes.push_back(index + 1);
+	}
+
+	reached.pop_back();
+
+	return reached;
+}
+
+// go to the next lexeme does nothing
+vector<bool> Optimizer::markUselessJumps() const {
+	vector<bool> keep(rpn.size(), true);
+
+	for (size_t i = 1; i < rpn.size(); i++)
+		if (rpn[i].getType() == LexemeT::rpn_go && stoul(rpn[i - 1].getValue()) == i + 1)
+			keep[i - 1] = keep[i] = false;
+
+	return keep;
+}
+
+void Optimizer::printReversePolishNotation() const {
+	cout << BOLDMAGENTA << "Optimized reverse polish notation (constant expressions folded: " << foldedCount << ", instructions removed: " << removedCount << "):" << RESET << endl;
+
+	for (auto i = rpn.begin(); i < rpn.end(); i++)
+		cout << i->printForRPN() << " ";
+
+	cout << endl << endl;
+}
+
+vector<Lexeme>& Optimizer::optimize() {
+	size_t folded, removed;
+
+	// removing of branches can make new constant expressions
+	do {
+		folded = foldedCount;
+		foldConstants();
+		threadJumps();
+
+		removed = compact(foldBranches());
+		removed += compact(markReachable());
+		removed += compact(markUselessJumps());
+
+		removedCount += removed;
+	} while (removed || folded != foldedCount);
+
+	return rpn;
+}
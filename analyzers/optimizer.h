@@ -0,0 +1,44 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../enums.h"
+#include "../entities/lexeme.h"
+#include "../entities/identifiersTable.h"
+#include "../entities/program.h"
+#include "../entities/value.h"
+
+#include "compiler.h"
+#include "executor.h"
+
+class Optimizer {
+	std::vector<Lexeme> rpn; // reverse polish notation
+	size_t foldedCount; // number of folded constant expressions
+	size_t removedCount; // number of removed instructions
+
+	std::vector<bool> jumpTargets() const;
+	void remapLabels(std::vector<Lexeme>& code, const std::vector<unsigned long>& positions) const;
+	size_t compact(const std::vector<bool>& keep);
+
+	int foldArity(const Lexeme& lexeme) const;
+	bool evaluate(std::vector<Lexeme>& expression, Lexeme& result) const;
+
+	void foldConstants();
+
+	void threadJumps();
+	std::vector<bool> foldBranches();
+	std::vector<bool> markReachable() const;
+	std::vector<bool> markUselessJumps() const;
+
+public:
+	Optimizer(std::vector<Lexeme>& rpn);
+
+	void printReversePolishNotation() const;
+
+	std::vector<Lexeme>& optimize();
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "script.h"
+
+using namespace std;
+
+ScriptResult::ScriptResult(ScriptStatus status, const string& message, unsigned long line) {
+	this->status = status;
+	this->message = message;
+	this->line = line;
+}
+
+bool ScriptResult::isOk() const {
+	return status == ScriptStatus::ok;
+}
+
+Script::Script() {
+	this->compiled = false;
+}
+
+ScriptResult Script::compile(const string& source, bool optimize) {
+	compiled = false;
+
+	ScriptResult result;
+
+	try {
+		string text = source;
+		LexicalAnalyzer lexicalAnalyzer(text);
+
+		result.warnings = lexicalAnalyzer.getWarnings();
+
+		vector<Lexeme>& lexemes = lexicalAnalyzer.analyze();
+
+		if (lexemes.size() < 2) {
+			result.status = ScriptStatus::no_lexemes;
+			result.message = "No lexemes founded";
+			return result;
+		}
+
+		SyntaxAnalyzer syntaxAnalyzer(lexicalAnalyzer.getTextLines(), lexemes, lexicalAnalyzer.getIdentifiersTable());
+
+		if (!syntaxAnalyzer.analyze(false)) {
+			result.status = ScriptStatus::syntax_error;
+			result.message = syntaxAnalyzer.getError();
+			result.line = syntaxAnalyzer.getErrorLine() + 1;
+			return result;
+		}
+
+		Optimizer optimizer(syntaxAnalyzer.getReversePolishNotation());
+		vector<Lexeme>& rpn = optimize ? optimizer.optimize() : syntaxAnalyzer.getReversePolishNotation();
+
+		Compiler compiler(syntaxAnalyzer.getIdentifiersTable(), rpn);
+
+		program = compiler.compile(optimize);
+		identifiersTable = syntaxAnalyzer.getIdentifiersTable();
+	}
+	catch (string e) {
+		result.status = ScriptStatus::compile_error;
+		result.message = e;
+		return result;
+	}
+
+	compiled = true;
+
+	return result;
+}
+
+// stdin is one stream for all scripts, so input read ahead by block in one run must stay for next runs
+static InputBuffer& stdinInput() {
+	static InputBuffer input;
+
+	return input;
+}
+
+ScriptResult Script::run(const InputReader& reader, const OutputWriter& writer, size_t bufferSize) const {
+	if (!compiled)
+		return ScriptResult(ScriptStatus::not_compiled, "Script isn't compiled");
+
+	Executor executor(identifiersTable, program, bufferSize);
+
+	if (reader)
+		executor.setIO(reader, writer);
+	else {
+		executor.setIO(nullptr, writer);
+		executor.setInput(stdinInput());
+	}
+
+	try {
+		executor.run();
+	}
+	catch (string e) {
+		return ScriptResult(ScriptStatus::execution_error, e);
+	}
+
+	return ScriptResult();
+}
+
+bool Script::isCompiled() const {
+	return compiled;
+}
+
+const Program& Script::getProgram() const {
+	return program;
+}
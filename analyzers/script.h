@@ -0,0 +1,51 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <string>
+#include <vector>
+
+#include "../enums.h"
+#include "../entities/lexeme.h"
+#include "../entities/identifiersTable.h"
+#include "../entities/program.h"
+#include "../entities/inputBuffer.h"
+#include "../entities/outputBuffer.h"
+
+#include "lexicalAnalyzer.h"
+#include "syntaxAnalyzer.h"
+#include "optimizer.h"
+#include "compiler.h"
+#include "executor.h"
+
+// result of compilation or run of script
+class ScriptResult {
+public:
+	ScriptStatus status;
+	std::string message; // error message (empty for ok)
+	unsigned long line; // line of syntax error counted from 1 (0 if it's unknown)
+	std::vector<std::string> warnings; // warnings of compilation (for example zero bytes in source)
+
+	ScriptResult(ScriptStatus status = ScriptStatus::ok, const std::string& message = "", unsigned long line = 0);
+
+	bool isOk() const;
+};
+
+// program compiled once and executed many times, every run starts with initial values of variables
+// run doesn't change script, so one script can be executed by several threads, if they don't read stdin
+// runs without own reader share one buffer of stdin: input read ahead by one run is read by the next one
+class Script {
+	IdentifiersTable identifiersTable;
+	Program program;
+	bool compiled;
+
+public:
+	Script();
+
+	ScriptResult compile(const std::string& source, bool optimize = true);
+	ScriptResult run(const InputReader& reader = nullptr, const OutputWriter& writer = nullptr, size_t bufferSize = 65536) const; // stdin and stdout by default
+
+	bool isCompiled() const;
+	const Program& getProgram() const;
+};
+
+#endif
@@ -8,6 +8,8 @@ SyntaxAnalyzer::SyntaxAnalyzer(vector<string> &lines, vector<Lexeme> &lexemes, I
 	this->identifiersTable = identifiersTable;
 
 	this->posLexeme = 0;
+	this->slotsCount = 0;
+	this->errorLine = 0;
 }
 
 Lexeme &SyntaxAnalyzer::currLexeme() {
@@ -22,15 +24,21 @@ bool SyntaxAnalyzer::haveLexemes() {
 	return currLexeme().getType() != LexemeT::null;
 }
 
+// all unknown lexemes are reported in one error with line of the first of them
 void SyntaxAnalyzer::checkLexemes() {
 	bool haveUnknownLexemes = false;
 	Lexeme unknownLex;
+	string message;
 
 	for(auto i = lexemes.begin(); i < lexemes.end(); i++) {
 		if (i->getType() == LexemeT::unknown) {
-			cout << BOLDRED << endl << "Lexical error: " << i->getValue() << " on line " << (i->getLineNumber() + 1) << RESET;
+			if (!haveUnknownLexemes)
+				unknownLex = *i;
+			else
+				message += "\n";
+
+			message += "Lexical error: " + i->getValue() + " on line " + to_string(i->getLineNumber() + 1);
 			haveUnknownLexemes = true;
-			unknownLex = *i;
 		}
 		else if (i->getType() == LexemeT::constant_real) {
 			string& value = i->getValue();
@@ -48,7 +56,7 @@ void SyntaxAnalyzer::checkLexemes() {
 	}
 
 	if (haveUnknownLexemes) {
-		unknownLex.setValue("There are unknown lexemes in file.");
+		unknownLex.setValue(message);
 		throw unknownLex;
 	}
 }
@@ -102,6 +110,7 @@ void SyntaxAnalyzer::declaration(IdentifierT identT) {
 			throw "'" + identifier->getName() + "' is already declared";
 		
 		identifier->setDeclared(true);
+		identifier->setSlot(slotsCount++);
 		identifier->setType(identT);
 		identifier->setDefaultValue();
 
@@ -126,8 +135,7 @@ void SyntaxAnalyzer::declaration(IdentifierT identT) {
 			if (!lexeme.isConstant())
 				throw "Constant value expected. " + lexeme.getValue() + " is not a constant.";
 			else if (lexeme.equalTypes(identT)) {
-				lexeme.setValue(sign + lexeme.getValue());
-				(&(*identifier))->setValue(lexeme.getValue());
+				identifier->setValue(Value(identT, sign + lexeme.getValue()));
 				nextLexeme();
 			} else 
 				throw "Type of constant value (" + lexeme.getValue() + ") doesn't match with identifier type (" + identifier->printType() + ")";
@@ -194,7 +202,7 @@ void SyntaxAnalyzer::assignment() {
 		//rpn.push_back(Lexeme(LexemeT::identifier, leftLexeme.getValue()));
 		
 		Lexeme sign;
-		string& value = currLexeme().getValue();
+		string value = currLexeme().getValue();
 
 		if(value == LEX_ADD_VALUE)
 			sign = Lexeme(LexemeT::delimeter, LEX_PLUS);
@@ -210,7 +218,14 @@ void SyntaxAnalyzer::assignment() {
 
 		overallType(leftType, sign, rightType);
 
-		rpn.push_back(Lexeme(LexemeT::rpn_short_op, sign.getValue()));
+		if (leftType == IdentifierT::identifier_int && rightType == IdentifierT::identifier_real)
+			throw "'" + value + "' incompatible with given types ('" + printIdentifierT(leftType) + "' and '" + printIdentifierT(rightType) + "')";
+
+		insertCast(rpn.size(), rightType, leftType);
+
+		Lexeme shortOp(LexemeT::rpn_short_op, sign.getValue());
+		shortOp.setValueType(leftType);
+		rpn.push_back(shortOp);
 		//rpn.push_back(Lexeme(LexemeT::delimeter, sign.getValue()));
 		//rpn.push_back(Lexeme(LexemeT::delimeter, LEX_EQUALS));
 	}
@@ -234,6 +249,7 @@ void SyntaxAnalyzer::assignment() {
 				  + rightLexeme.getValue() + "' that has type " + printIdentifierT(rightType);
 		}
 
+		insertCast(rpn.size(), rightType, leftType);
 		rpn.push_back(Lexeme(LexemeT::delimeter, LEX_EQUALS));
 	}
 }
@@ -309,13 +325,105 @@ IdentifierT SyntaxAnalyzer::overallType(IdentifierT leftType, Lexeme& sign, Iden
 	throw "'" + sign.getValue() + "' is not a proper sign";
 }
 
+// type to which both operands are converted before operation
+IdentifierT SyntaxAnalyzer::operandsType(IdentifierT leftType, IdentifierT rightType) {
+	if (leftType == rightType || leftType == IdentifierT::identifier_string)
+		return leftType;
+
+	return IdentifierT::identifier_real;
+}
+
+// labels pointing after index are shifted, labels pointing to index now point to the cast
+void SyntaxAnalyzer::insertCast(unsigned long index, IdentifierT fromType, IdentifierT toType) {
+	if (fromType == toType)
+		return;
+
+	Lexeme cast(LexemeT::rpn_cast, printIdentifierT(toType));
+	cast.setValueType(fromType);
+
+	for (size_t i = 0; i < rpn.size(); i++) {
+		if (rpn[i].getType() != LexemeT::rpn_label)
+			continue;
+
+		long target = stol(rpn[i].getValue());
+
+		if (target > (long) index)
+			rpn[i].setValue(to_string(target + 1));
+	}
+
+	rpn.insert(rpn.begin() + index, cast);
+}
+
+IdentifierT SyntaxAnalyzer::binaryOperation(Lexeme sign, IdentifierT leftType, unsigned long leftEnd, IdentifierT rightType) {
+	IdentifierT overall = overallType(leftType, sign, rightType);
+	IdentifierT operandsT = operandsType(leftType, rightType);
+
+	insertCast(rpn.size(), rightType, operandsT);
+	insertCast(leftEnd, leftType, operandsT);
+
+	sign.setValueType(operandsT);
+	rpn.push_back(sign);
+
+	return overall;
+}
+
+void SyntaxAnalyzer::pushUnaryMinus(IdentifierT identT) {
+	if (identT != IdentifierT::identifier_real && identT != IdentifierT::identifier_int)
+		throw "unary minus is incompatible with type " + printIdentifierT(identT);
+
+	Lexeme minus(LexemeT::rpn_minus, LEX_MINUS);
+	minus.setValueType(identT);
+	rpn.push_back(minus);
+}
+
+// a and b: a L1 fgo b L2 go L1: false L2:
+IdentifierT SyntaxAnalyzer::logicAnd(Lexeme& sign, IdentifierT leftType) {
+	unsigned long falseIndex = rpn.size();
+	rpn.push_back(Lexeme(LexemeT::rpn_label, "0"));
+	rpn.push_back(Lexeme(LexemeT::rpn_fgo, "0"));
+
+	IdentifierT rightType = entity();
+	IdentifierT overall = overallType(leftType, sign, rightType);
+
+	unsigned long endIndex = rpn.size();
+	rpn.push_back(Lexeme(LexemeT::rpn_label, "0"));
+	rpn.push_back(Lexeme(LexemeT::rpn_go, "0"));
+	rpn[falseIndex].setValue(to_string(rpn.size()));
+
+	rpn.push_back(Lexeme(LexemeT::constant_boolean, LEX_FALSE));
+	rpn[endIndex].setValue(to_string(rpn.size()));
+
+	return overall;
+}
+
+// a or b: a L1 fgo true L2 go L1: b L2:
+IdentifierT SyntaxAnalyzer::logicOr(Lexeme& sign, IdentifierT leftType) {
+	unsigned long rightIndex = rpn.size();
+	rpn.push_back(Lexeme(LexemeT::rpn_label, "0"));
+	rpn.push_back(Lexeme(LexemeT::rpn_fgo, "0"));
+
+	rpn.push_back(Lexeme(LexemeT::constant_boolean, LEX_TRUE));
+
+	unsigned long endIndex = rpn.size();
+	rpn.push_back(Lexeme(LexemeT::rpn_label, "0"));
+	rpn.push_back(Lexeme(LexemeT::rpn_go, "0"));
+	rpn[rightIndex].setValue(to_string(rpn.size()));
+
+	IdentifierT rightType = term1();
+	IdentifierT overall = overallType(leftType, sign, rightType);
+
+	rpn[endIndex].setValue(to_string(rpn.size()));
+
+	return overall;
+}
+
 IdentifierT SyntaxAnalyzer::unaryMinus() {
 	LexemeT lexT = currLexeme().getType();
 
 	if (currLexeme().isConstant()) {
 		if (lexT == LexemeT::constant_real || lexT == LexemeT::constant_int) {
 			rpn.push_back(Lexeme(currLexeme().getType(), currLexeme().getValue()));
-			rpn.push_back(Lexeme(LexemeT::rpn_minus, LEX_MINUS));
+			pushUnaryMinus(currLexeme().constantToIdentifier());
 
 			Lexeme& curLex = currLexeme();
 			nextLexeme();
@@ -337,11 +445,7 @@ IdentifierT SyntaxAnalyzer::unaryMinus() {
 
 		IdentifierT identT = identifier->getType();
 
-		if (identT == IdentifierT::identifier_real || identT == IdentifierT::identifier_int)
-			rpn.push_back(Lexeme(LexemeT::rpn_minus, LEX_MINUS));
-		else 
-			throw "unary minus is incompatible with type " + printIdentifierT(identT);
-		
+		pushUnaryMinus(identT);
 		nextLexeme();
 
 		return identT;
@@ -353,7 +457,7 @@ IdentifierT SyntaxAnalyzer::unaryMinus() {
 		checkDelimeter(LEX_RPARENTHESIS);
 		nextLexeme();
 
-		rpn.push_back(Lexeme(LexemeT::rpn_minus, LEX_MINUS));
+		pushUnaryMinus(entT);
 
 		return entT;
 	}
@@ -381,16 +485,23 @@ IdentifierT SyntaxAnalyzer::ternaryOp(IdentifierT identT) {
 
 	IdentifierT secondExprT = expression();
 
-	rpn[exp2Index].setValue(to_string(rpn.size()));
+	IdentifierT resultT = firstExprT;
 
-	if (secondExprT == firstExprT)
-		return firstExprT;
+	if (secondExprT != firstExprT) {
+		if ((firstExprT == IdentifierT::identifier_int || firstExprT == IdentifierT::identifier_real) &&
+			(secondExprT == IdentifierT::identifier_int || secondExprT == IdentifierT::identifier_real))
+			resultT = IdentifierT::identifier_real;
+		else
+			throw string("The types of expressions in the ternary operator must match");
+	}
+
+	insertCast(rpn.size(), secondExprT, resultT);
+	rpn[exp2Index].setValue(to_string(rpn.size()));
 
-	if ((firstExprT == IdentifierT::identifier_int || firstExprT == IdentifierT::identifier_real) &&
-		(secondExprT == IdentifierT::identifier_int || secondExprT == IdentifierT::identifier_real))
-		return IdentifierT::identifier_real;
+	// both branches must leave value of the same type
+	insertCast(exp2Index, firstExprT, resultT);
 
-	throw string("The types of expressions in the ternary operator must match");
+	return resultT;
 }
 
 IdentifierT SyntaxAnalyzer::expression() {
@@ -406,11 +517,9 @@ IdentifierT SyntaxAnalyzer::expression() {
 		Lexeme& sign = currLexeme();
 		nextLexeme();
 
+		unsigned long leftEnd = rpn.size();
 		IdentifierT rightType = term();
-
-		rpn.push_back(sign);
-
-		IdentifierT overall = overallType(leftType, sign, rightType);
+		IdentifierT overall = binaryOperation(sign, leftType, leftEnd, rightType);
 
 		if (currLexeme().check(LexemeT::delimeter, LEX_QUESTION)) {
 			nextLexeme();
@@ -437,11 +546,16 @@ IdentifierT SyntaxAnalyzer::term() {
 
 		Lexeme& sign = currLexeme();
 		nextLexeme();
-		IdentifierT rightType = term1();
 
-		rpn.push_back(sign);
+		if (sign.check(LexemeT::keyword, LEX_OR)) {
+			leftType = logicOr(sign, leftType);
+			continue;
+		}
+
+		unsigned long leftEnd = rpn.size();
+		IdentifierT rightType = term1();
 
-		leftType = overallType(leftType, sign, rightType);
+		leftType = binaryOperation(sign, leftType, leftEnd, rightType);
 	}
 
 	return leftType;
@@ -457,11 +571,16 @@ IdentifierT SyntaxAnalyzer::term1() {
 
 		Lexeme& sign = currLexeme();
 		nextLexeme();
-		IdentifierT rightType = entity();
 
-		rpn.push_back(sign);
+		if (sign.check(LexemeT::keyword, LEX_AND)) {
+			leftType = logicAnd(sign, leftType);
+			continue;
+		}
 
-		leftType = overallType(leftType, sign, rightType);
+		unsigned long leftEnd = rpn.size();
+		IdentifierT rightType = entity();
+
+		leftType = binaryOperation(sign, leftType, leftEnd, rightType);
 	}
 
 	return leftType;
@@ -542,6 +661,17 @@ void SyntaxAnalyzer::parseIf() {
 	rpn[ifIndex].setValue(to_string(rpn.size()));
 }
 
+// appends lexemes cut from rpn at index (step of for loop), their labels (and/or, ternary operator) are shifted to new place
+void SyntaxAnalyzer::appendMoved(vector<Lexeme>& lexemes, unsigned long index) {
+	unsigned long shift = rpn.size() - index;
+
+	for (size_t i = 0; i < lexemes.size(); i++)
+		if (lexemes[i].getType() == LexemeT::rpn_label)
+			lexemes[i].setValue(to_string(stol(lexemes[i].getValue()) + shift));
+
+	rpn.insert(rpn.end(), lexemes.begin(), lexemes.end());
+}
+
 void SyntaxAnalyzer::parseFor() {
 	unsigned long startIndex = rpn.size();
 
@@ -574,9 +704,10 @@ void SyntaxAnalyzer::parseFor() {
 		nextLexeme();
 
 		vector <Lexeme> tmp;
+		unsigned long assignmentIndex = 0;
 
 		if (!currLexeme().check(LexemeT::delimeter, LEX_RPARENTHESIS)) {
-			unsigned long assignmentIndex = rpn.size();
+			assignmentIndex = rpn.size();
 			assignment();
 			unsigned long assignmentCount = rpn.size() - assignmentIndex;
 
@@ -591,7 +722,7 @@ void SyntaxAnalyzer::parseFor() {
 		nextLexeme();
 		parse();
 		
-		rpn.insert(rpn.end(), tmp.begin(), tmp.end());
+		appendMoved(tmp, assignmentIndex);
 		rpn.push_back(Lexeme(LexemeT::rpn_label, to_string(expressionIndex)));
 		rpn.push_back(Lexeme(LexemeT::rpn_go, "0"));
 		rpn[expressionLabel1].setValue(to_string(rpn.size()));
@@ -599,9 +730,10 @@ void SyntaxAnalyzer::parseFor() {
 		nextLexeme();
 
 		vector <Lexeme> tmp;
+		unsigned long assignmentIndex = 0;
 
 		if (!currLexeme().check(LexemeT::delimeter, LEX_RPARENTHESIS)) {
-			unsigned long assignmentIndex = rpn.size();
+			assignmentIndex = rpn.size();
 			assignment();
 			unsigned long assignmentCount = rpn.size() - assignmentIndex;
 
@@ -616,7 +748,7 @@ void SyntaxAnalyzer::parseFor() {
 		nextLexeme();
 		parse();
 
-		rpn.insert(rpn.end(), tmp.begin(), tmp.end());
+		appendMoved(tmp, assignmentIndex);
 		rpn.push_back(Lexeme(LexemeT::rpn_label, to_string(expressionIndex)));
 		rpn.push_back(Lexeme(LexemeT::rpn_go, "0"));		
 	}
@@ -808,7 +940,17 @@ IdentifiersTable& SyntaxAnalyzer::getIdentifiersTable() {
 	return identifiersTable;
 }
 
-bool SyntaxAnalyzer::analyze() {
+const string& SyntaxAnalyzer::getError() const {
+	return error;
+}
+
+unsigned long SyntaxAnalyzer::getErrorLine() const {
+	return errorLine;
+}
+
+bool SyntaxAnalyzer::analyze(bool printErrors) {
+	bool failed = false;
+
 	try {
 		checkLexemes();
 		checkProgram();
@@ -824,16 +966,23 @@ bool SyntaxAnalyzer::analyze() {
 				throw string("Break statement not within loop");
 	}
 	catch (string &e) {
-		cout << endl << YELLOW << lines[currLexeme().getLineNumber()] << RESET << "\t (line " << (currLexeme().getLineNumber() + 1)<< ")" << endl;
-		cout << BOLDRED << e << RESET << endl;
-
-		return false;
+		error = e;
+		errorLine = currLexeme().getLineNumber();
+		failed = true;
 	}
 	catch (Lexeme &lex) {
-		cout << endl << YELLOW << lines[lex.getLineNumber()] << RESET << "\t (line " << (lex.getLineNumber() + 1)<< ")" << endl;
-		cout << BOLDRED << lex.getValue() << RESET << endl;
+		error = lex.getValue();
+		errorLine = lex.getLineNumber();
+		failed = true;
+	}
+
+	if (failed) {
+		if (printErrors) {
+			cout << endl << YELLOW << lines[errorLine] << RESET << "\t (line " << (errorLine + 1)<< ")" << endl;
+			cout << BOLDRED << error << RESET << endl;
+		}
 
-		return false;	
+		return false;
 	}
 
 	return true;
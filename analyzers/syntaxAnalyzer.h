@@ -17,6 +17,10 @@ class SyntaxAnalyzer {
 	std::vector<Lexeme> rpn; // reverse Polish notation
 
 	size_t posLexeme;
+	int slotsCount; // number of declared identifiers
+
+	std::string error; // message of syntax error
+	unsigned long errorLine;
 
 	Lexeme& currLexeme();
 	Lexeme& nextLexeme();
@@ -38,6 +42,14 @@ class SyntaxAnalyzer {
 
 	IdentifierT invertEntity(IdentifierT identT);
 	IdentifierT overallType(IdentifierT leftType, Lexeme& sign, IdentifierT rightType);
+	IdentifierT operandsType(IdentifierT leftType, IdentifierT rightType);
+
+	void insertCast(unsigned long index, IdentifierT fromType, IdentifierT toType);
+	IdentifierT binaryOperation(Lexeme sign, IdentifierT leftType, unsigned long leftEnd, IdentifierT rightType);
+	void pushUnaryMinus(IdentifierT identT);
+
+	IdentifierT logicAnd(Lexeme& sign, IdentifierT leftType);
+	IdentifierT logicOr(Lexeme& sign, IdentifierT leftType);
 
 	IdentifierT unaryMinus();
 	IdentifierT ternaryOp(IdentifierT identT);
@@ -49,6 +61,7 @@ class SyntaxAnalyzer {
 
 	// RPN
 	void insertBreakLabels(unsigned long startIndex, unsigned long endIndex, unsigned long labelIndex);
+	void appendMoved(std::vector<Lexeme>& lexemes, unsigned long index);
 
 	void parseIf();
 	void parseFor();
@@ -69,7 +82,10 @@ public:
 	std::vector<Lexeme>& getReversePolishNotation();
 	IdentifiersTable& getIdentifiersTable();
 
-	bool analyze();
+	bool analyze(bool printErrors = true);
+
+	const std::string& getError() const;
+	unsigned long getErrorLine() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "Integer.h"
+
+using namespace std;
+
+// keeps LongInt only if it can't be represented by long long
+void Integer::setBig(const LongInt& n) {
+	if (n.toLongLong(value))
+		big.reset();
+	else
+		big.reset(new LongInt(n));
+}
+
+Integer::Integer() {
+	value = 0;
+}
+
+Integer::Integer(long long v) {
+	value = v;
+}
+
+Integer::Integer(const LongInt& n) {
+	value = 0;
+	setBig(n);
+}
+
+Integer::Integer(const string& s) {
+	value = 0;
+	setBig(LongInt(s));
+}
+
+Integer::Integer(const Integer& n) {
+	value = n.value;
+
+	if (n.big)
+		big.reset(new LongInt(*n.big));
+}
+
+Integer::Integer(const LongDouble& x) {
+	vector<uint32_t> limbs = x.intLimbs();
+
+	if (limbs.size() > 2) {
+		value = 0;
+		setBig(LongInt(limbs, x.isNegative()));
+		return;
+	}
+
+	value = limbs[0] + (limbs.size() == 2 ? (long long) limbs[1] * LONG_INT_BASE : 0); // less than 10^18
+
+	if (x.isNegative())
+		value = -value;
+}
+
+Integer& Integer::operator=(const Integer& n) {
+	if (this == &n)
+		return *this;
+
+	value = n.value;
+
+	if (!n.big)
+		big.reset();
+	else if (big)
+		*big = *n.big;
+	else
+		big.reset(new LongInt(*n.big));
+
+	return *this;
+}
+
+bool Integer::isBig() const {
+	return big != nullptr;
+}
+
+bool Integer::isZero() const {
+	return big ? big->isZero() : value == 0;
+}
+
+size_t Integer::digitsCount() const {
+	return big ? big->digitsCount() : 0;
+}
+
+LongInt Integer::toLongInt() const {
+	return big ? *big : LongInt(value);
+}
+
+LongDouble Integer::toLongDouble() const {
+	if (big)
+		return LongDouble(big->getLimbs(), big->isNegative());
+
+	vector<uint32_t> limbs;
+	unsigned long long v = value < 0 ? 0 - (unsigned long long) value : value;
+
+	do {
+		limbs.push_back(v % LONG_INT_BASE);
+		v /= LONG_INT_BASE;
+	} while (v);
+
+	return LongDouble(limbs, value < 0);
+}
+
+bool Integer::operator>(const Integer& n) const {
+	if (!big && !n.big)
+		return value > n.value;
+
+	return toLongInt() > n.toLongInt();
+}
+
+bool Integer::operator<(const Integer& n) const {
+	if (!big && !n.big)
+		return value < n.value;
+
+	return toLongInt() < n.toLongInt();
+}
+
+bool Integer::operator==(const Integer& n) const {
+	if (!big && !n.big)
+		return value == n.value;
+
+	return toLongInt() == n.toLongInt();
+}
+
+bool Integer::operator!=(const Integer& n) const {
+	return !(*this == n);
+}
+
+bool Integer::operator>=(const Integer& n) const {
+	if (!big && !n.big)
+		return value >= n.value;
+
+	return toLongInt() >= n.toLongInt();
+}
+
+bool Integer::operator<=(const Integer& n) const {
+	if (!big && !n.big)
+		return value <= n.value;
+
+	return toLongInt() <= n.toLongInt();
+}
+
+// LongInt keeps negative zero after unary minus, so it is done by LongInt for zero
+Integer Integer::operator-() const {
+	if (!big && value != 0 && value != LLONG_MIN)
+		return Integer(-value);
+
+	return Integer(-toLongInt());
+}
+
+Integer Integer::operator+(const Integer& n) const {
+	long long res;
+
+	if (!big && !n.big && !__builtin_add_overflow(value, n.value, &res))
+		return Integer(res);
+
+	return Integer(toLongInt() + n.toLongInt());
+}
+
+Integer Integer::operator-(const Integer& n) const {
+	long long res;
+
+	if (!big && !n.big && !__builtin_sub_overflow(value, n.value, &res))
+		return Integer(res);
+
+	return Integer(toLongInt() - n.toLongInt());
+}
+
+Integer Integer::operator*(const Integer& n) const {
+	long long res;
+
+	if (!big && !n.big && !__builtin_mul_overflow(value, n.value, &res))
+		return Integer(res);
+
+	return Integer(toLongInt() * n.toLongInt());
+}
+
+// division truncates to zero and remainder has sign of dividend, as in LongInt
+Integer Integer::operator/(const Integer& n) const {
+	if (!big && !n.big && !(value == LLONG_MIN && n.value == -1))
+		return Integer(value / n.value);
+
+	// big integer by single limb divisor: linear short division without LongInt for divisor
+	if (big && !n.big && n.value != 0 && n.value > -LONG_INT_BASE && n.value < LONG_INT_BASE) {
+		LongInt quotient(n.value < 0 ? -*big : *big);
+		quotient.divShort(n.value < 0 ? -n.value : n.value);
+
+		return Integer(quotient);
+	}
+
+	return Integer(toLongInt() / n.toLongInt());
+}
+
+Integer Integer::operator%(const Integer& n) const {
+	if (!big && !n.big)
+		return Integer(n.value == -1 ? 0 : value % n.value);
+
+	// remainder by single limb divisor is calculated without quotient
+	if (big && !n.big && n.value != 0 && n.value > -LONG_INT_BASE && n.value < LONG_INT_BASE) {
+		long long remainder = big->modShort(n.value < 0 ? -n.value : n.value);
+
+		return Integer(big->isNegative() ? -remainder : remainder);
+	}
+
+	return Integer(toLongInt() % n.toLongInt());
+}
+
+string Integer::toString() const {
+	return big ? big->toString() : to_string(value);
+}
+
+ostream& operator<<(ostream &fs, const Integer &n) {
+	if (n.big)
+		return fs << *n.big;
+
+	return fs << n.value;
+}
@@ -0,0 +1,55 @@
+#ifndef INTEGER_H
+#define INTEGER_H
+
+#include <iostream>
+#include <climits>
+#include <memory>
+#include <string>
+
+#include "LongInt.h"
+#include "LongDouble.h"
+
+// integer with native 64-bit representation, which is promoted to LongInt on overflow
+class Integer {
+	long long value; // value of small integer
+	std::unique_ptr<LongInt> big; // value of big integer (nullptr for small integer)
+
+	void setBig(const LongInt& n);
+
+public:
+	Integer();
+	Integer(long long v);
+	Integer(const LongInt& n);
+	Integer(const std::string& s);
+	Integer(const Integer& n);
+	explicit Integer(const LongDouble& x); // integer part of real value
+
+	Integer& operator=(const Integer& n);
+
+	bool isBig() const;
+	bool isZero() const; // true for 0 and big -0
+	size_t digitsCount() const; // digits of big integer (0 for small integer)
+	LongInt toLongInt() const;
+	LongDouble toLongDouble() const;
+
+	bool operator>(const Integer& n) const;
+	bool operator<(const Integer& n) const;
+	bool operator==(const Integer& n) const;
+	bool operator!=(const Integer& n) const;
+	bool operator>=(const Integer& n) const;
+	bool operator<=(const Integer& n) const;
+
+	Integer operator-() const;
+
+	Integer operator+(const Integer& n) const;
+	Integer operator-(const Integer& n) const;
+	Integer operator*(const Integer& n) const;
+	Integer operator/(const Integer& n) const;
+	Integer operator%(const Integer& n) const;
+
+	std::string toString() const;
+
+	friend std::ostream& operator<<(std::ostream &fs, const Integer &n);
+};
+
+#endif
@@ -1,7 +1,22 @@
 #include "LongDouble.h"
+#include "NTT.h"
 
 using namespace std;
 
+const uint32_t powers10[9] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+// digits of mantissa (most significant first) to base 10^9 digits (least significant first)
+static vector<uint32_t> toLimbs(const vector<int>& digits) {
+	vector<uint32_t> limbs((digits.size() + 8) / 9, 0);
+
+	for (size_t i = 0; i < digits.size(); i++) {
+		size_t position = digits.size() - 1 - i;
+		limbs[position / 9] += digits[i] * powers10[position % 9];
+	}
+
+	return limbs;
+}
+
 void LongDouble::initFromString(const string& s) {
 	size_t index;
 
@@ -47,49 +62,53 @@ void LongDouble::removeZeroes() {
 	normalize();
 }
 
+// long run of nines in fraction (0.333... * 3) is rounded up to the previous digit
 void LongDouble::normalize() {
 	size_t start = max(exponent, (long) 0);
-	size_t realDigits = digits.size() - start;
 
-	if (realDigits >= divDigits) {
-		size_t count = 0;
-		size_t maxCount = 0;
+	if (digits.size() < start || digits.size() - start < divDigits)
+		return;
 
-		size_t i = start;
+	size_t runStart = 0;
+	size_t maxCount = 0;
 
-		while(i < digits.size()) {
-			count = 0;
+	for (size_t i = start; i < digits.size(); i++) {
+		if (digits[i] != 9)
+			continue;
 
-			while (i < digits.size() && digits[i] == 9) {
-				count++;
-				i++;
-			}
-			
-			if (count > maxCount)
-				maxCount = count;
+		size_t j = i;
 
-			i++;
+		while (j < digits.size() && digits[j] == 9)
+			j++;
+
+		if (j - i > maxCount) {
+			maxCount = j - i;
+			runStart = i;
 		}
-		
-		if (maxCount > divDigits * 4 / 5) {
-			i = digits.size() - 1;
 
-			do {
-				count = 0;
+		i = j;
+	}
 
-				while (i > 0 && digits[i] != 9)
-					i--;
+	if (maxCount <= divDigits * 4 / 5)
+		return;
 
-				while (i > 0 && digits[i] == 9) {
-					count++;
-					i--;
-				}
-			} while (count != maxCount);
+	digits.erase(digits.begin() + runStart, digits.end());
 
-			digits.erase(digits.begin() + i + 1, digits.end());
-			digits[i]++;
-		}
+	size_t i = runStart;
+
+	while (i > 0 && digits[i - 1] == 9)
+		digits[--i] = 0;
+
+	if (i > 0) {
+		digits[i - 1]++;
 	}
+	else {
+		digits.insert(digits.begin(), 1);
+		exponent++;
+	}
+
+	while (digits.size() > 1 && digits.back() == 0)
+		digits.pop_back();
 }
 
 LongDouble::LongDouble() {
@@ -101,10 +120,7 @@ LongDouble::LongDouble() {
 LongDouble::LongDouble(const LongDouble& x) {
 	sign = x.sign;
 	exponent = x.exponent;
-	digits = vector<int>(x.digits.size());
-
-	for (size_t i = 0; i < x.digits.size(); i++)
-		digits[i] = x.digits[i];
+	digits = x.digits;
 }
 
 LongDouble::LongDouble(long double value) {
@@ -120,16 +136,42 @@ LongDouble::LongDouble(const string& s) {
 	removeZeroes();
 }
 
+LongDouble::LongDouble(const vector<uint32_t>& limbs, bool negative) {
+	size_t size = limbs.size();
+
+	while (size > 0 && limbs[size - 1] == 0)
+		size--;
+
+	sign = negative && size ? -1 : 1;
+	exponent = 1;
+
+	if (!size) {
+		digits = vector<int>(1, 0);
+		return;
+	}
+
+	size_t length = 1; // digits of the most significant limb
+
+	while (length < 9 && limbs[size - 1] >= powers10[length])
+		length++;
+
+	digits.reserve(length + (size - 1) * 9);
+
+	for (size_t i = size; i > 0; i--)
+		for (size_t k = i == size ? length : 9; k > 0; k--)
+			digits.push_back(limbs[i - 1] / powers10[k - 1] % 10);
+
+	exponent = digits.size();
+	removeZeroes();
+}
+
 LongDouble& LongDouble::operator=(const LongDouble& x) {
 	if (this == &x)
 		return *this;
 
 	sign = x.sign;
 	exponent = x.exponent;
-	digits = vector<int>(x.digits.size());
-
-	for (size_t i = 0; i < x.digits.size(); i++)
-		digits[i] = x.digits[i];
+	digits = x.digits; // reuses allocated memory
 
 	return *this;
 }
@@ -138,6 +180,10 @@ bool LongDouble::operator>(const LongDouble& x) const {
 	if (sign != x.sign)
 		return sign > x.sign;
 
+	// exponent of zero is 1, so it can't be compared by exponent with numbers less than 1
+	if (isZero() || x.isZero())
+		return x.isZero() ? !isZero() && sign == 1 : sign == -1;
+
 	if (exponent != x.exponent)
 		return (exponent > x.exponent) ^ (sign == -1);
 
@@ -319,13 +365,25 @@ LongDouble LongDouble::operator*(const LongDouble& x) const {
 	res.digits = vector<int>(len, 0);
 	res.exponent = exponent + x.exponent;
 
-	for (size_t i = 0; i < digits.size(); i++)
-		for (size_t j = 0; j < x.digits.size(); j++)
-			res.digits[i + j + 1] += digits[i] * x.digits[j];
+	if (min(digits.size(), x.digits.size()) >= LONG_DOUBLE_NTT_THRESHOLD && len <= NTT_MAX_LENGTH) {
+		vector<uint32_t> a = toLimbs(digits);
+		vector<uint32_t> b = toLimbs(x.digits);
+		vector<uint32_t> product(a.size() + b.size());
+
+		nttMultiply(a.data(), a.size(), b.data(), b.size(), product.data());
 
-	for (size_t i = len - 1; i > 0; i--) {
-		res.digits[i - 1] += res.digits[i] / 10;
-		res.digits[i] %= 10;
+		for (size_t i = 0; i < len; i++)
+			res.digits[len - 1 - i] = product[i / 9] / powers10[i % 9] % 10;
+	}
+	else {
+		for (size_t i = 0; i < digits.size(); i++)
+			for (size_t j = 0; j < x.digits.size(); j++)
+				res.digits[i + j + 1] += digits[i] * x.digits[j];
+
+		for (size_t i = len - 1; i > 0; i--) {
+			res.digits[i - 1] += res.digits[i] / 10;
+			res.digits[i] %= 10;
+		}
 	}
 
 	res.removeZeroes();
@@ -530,14 +588,36 @@ bool LongDouble::isZero() const {
 	return digits.size() == 1 && digits[0] == 0;
 }
 
+bool LongDouble::isNegative() const {
+	return sign == -1;
+}
+
+size_t LongDouble::digitsCount() const {
+	return digits.size();
+}
+
+vector<uint32_t> LongDouble::intLimbs() const {
+	if (exponent < 1)
+		return vector<uint32_t>(1, 0);
+
+	vector<uint32_t> limbs((exponent + 8) / 9, 0);
+
+	for (size_t i = 0; i < digits.size() && i < (size_t) exponent; i++) {
+		size_t position = exponent - 1 - i;
+		limbs[position / 9] += digits[i] * powers10[position % 9];
+	}
+
+	return limbs;
+}
+
 string LongDouble::intToString() const {
 	if (exponent < 1)
 		return "0";
 
 	string s;
 
-	for (long i = 0; i < exponent; i++)
-		s += to_string(digits[i]);
+	for (size_t i = 0; i < (size_t) exponent; i++)
+		s += i < digits.size() ? to_string(digits[i]) : "0";
 
 	return s;
 }
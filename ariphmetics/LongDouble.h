@@ -1,9 +1,15 @@
+#ifndef LONG_DOUBLE_H
+#define LONG_DOUBLE_H
+
 #include <iostream>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#define LONG_DOUBLE_NTT_THRESHOLD 256 // digits of mantissa, from which multiplication uses NTT
+
 class LongDouble {
 	const size_t divDigits = 100;
 	const size_t sqrtDigits = 100;
@@ -21,6 +27,7 @@ public:
 	LongDouble(const LongDouble& x);
 	LongDouble(long double value);
 	LongDouble(const std::string& s);
+	LongDouble(const std::vector<uint32_t>& limbs, bool negative); // integer from base 10^9 limbs (least significant first)
 
 	LongDouble& operator=(const LongDouble& x);
 
@@ -58,9 +65,15 @@ public:
 	bool isEven() const;
 	bool isOdd() const;
 	bool isZero() const;
+	bool isNegative() const;
 
+	size_t digitsCount() const;
+
+	std::vector<uint32_t> intLimbs() const; // integer part of modulus in base 10^9 limbs (least significant first)
 	std::string intToString() const;
 	std::string toString() const;
 
 	friend std::ostream& operator<<(std::ostream& os, const LongDouble& value);
-};
\ No newline at end of file
+};
+
+#endif
\ No newline at end of file
@@ -1,97 +1,334 @@
 #include "LongInt.h"
+#include "NTT.h"
+#include <algorithm>
 
 using namespace std;
 
 void LongInt::removeZeroes() {
-	size_t index = 0;
+	while (limbs.size() > 1 && limbs.back() == 0)
+		limbs.pop_back();
+
+	leadingZeros = 0;
+
+	if (limbs.size() == 1 && limbs[0] == 0)
+		sign = 1;
+}
+
+int LongInt::compareAbs(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+	if (a.size() != b.size())
+		return a.size() > b.size() ? 1 : -1;
 
-	while (index < digits.size() - 1 && digits[index] == 0)
-		index++;
+	for (size_t i = a.size(); i > 0; i--)
+		if (a[i - 1] != b[i - 1])
+			return a[i - 1] > b[i - 1] ? 1 : -1;
 
-	vector<int> newDigits;
+	return 0;
+}
+
+void LongInt::addAbs(vector<uint32_t>& a, const vector<uint32_t>& b) {
+	if (a.size() < b.size())
+		a.resize(b.size(), 0);
+
+	uint32_t carry = 0;
 
-	while (index < digits.size()) {
-		newDigits.push_back(digits[index]);
-		index++;
+	for (size_t i = 0; i < a.size() && (carry || i < b.size()); i++) {
+		uint32_t curr = a[i] + carry + (i < b.size() ? b[i] : 0);
+		carry = curr >= LONG_INT_BASE;
+		a[i] = carry ? curr - LONG_INT_BASE : curr;
 	}
 
-	digits = newDigits;
+	if (carry)
+		a.push_back(carry);
+}
 
-	if (digits.size() == 1 && digits[0] == 0)
-		sign = 1;
+void LongInt::subAbs(vector<uint32_t>& a, const vector<uint32_t>& b) {
+	uint32_t borrow = 0;
+
+	for (size_t i = 0; i < a.size() && (borrow || i < b.size()); i++) {
+		uint32_t sub = borrow + (i < b.size() ? b[i] : 0);
+		borrow = a[i] < sub;
+		a[i] = borrow ? a[i] + LONG_INT_BASE - sub : a[i] - sub;
+	}
 }
 
-LongInt LongInt::mult2() const {
-	LongInt res;
+size_t LongInt::karatsubaThreshold = LONG_INT_KARATSUBA_THRESHOLD;
+size_t LongInt::nttThreshold = LONG_INT_NTT_THRESHOLD;
 
-	res.sign = sign;
-	res.digits = vector<int>(digits.size() + 1, 0);
+// умножение столбиком a[0..na) * b[0..nb), результат добавляется в res[0..na + nb)
+static void multSchool(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* res) {
+	for (size_t i = 0; i < na; i++) {
+		if (!a[i])
+			continue;
 
-	for (size_t i = 0; i < digits.size(); i++)
-		res.digits[i + 1] = digits[i];
+		uint64_t carry = 0;
 
-	int carry = 0;
+		for (size_t j = 0; j < nb; j++) {
+			uint64_t curr = (uint64_t) a[i] * b[j] + res[i + j] + carry;
+			res[i + j] = curr % LONG_INT_BASE;
+			carry = curr / LONG_INT_BASE;
+		}
 
-	for (int i = res.digits.size() - 1; i >= 0; i--) {
-		int curr = carry + res.digits[i] * 2;
-		res.digits[i] = curr % 10;
-		carry = curr / 10;
+		for (size_t k = i + nb; carry; k++) {
+			uint64_t curr = res[k] + carry;
+			res[k] = curr % LONG_INT_BASE;
+			carry = curr / LONG_INT_BASE;
+		}
 	}
+}
 
-	res.removeZeroes();
+// res[0..n) += x[0..nx), перенос за пределы res отбрасывается
+static void addRange(uint32_t* res, size_t n, const uint32_t* x, size_t nx) {
+	uint32_t carry = 0;
 
-	return res;
+	for (size_t i = 0; i < n && (carry || i < nx); i++) {
+		uint32_t curr = res[i] + carry + (i < nx ? x[i] : 0);
+		carry = curr >= LONG_INT_BASE;
+		res[i] = carry ? curr - LONG_INT_BASE : curr;
+	}
 }
 
-LongInt LongInt::div2() const {
-	LongInt res;
+// res[0..n) -= x[0..nx), res >= x
+static void subRange(uint32_t* res, size_t n, const uint32_t* x, size_t nx) {
+	uint32_t borrow = 0;
+
+	for (size_t i = 0; i < n && (borrow || i < nx); i++) {
+		uint32_t sub = borrow + (i < nx ? x[i] : 0);
+		borrow = res[i] < sub;
+		res[i] = borrow ? res[i] + LONG_INT_BASE - sub : res[i] - sub;
+	}
+}
 
-	res.sign = sign;
-	res.digits = vector<int>(digits.size(), 0);
+// длина без старших нулевых цифр (не меньше 1)
+static size_t significantLength(const uint32_t* a, size_t n) {
+	while (n > 1 && a[n - 1] == 0)
+		n--;
 
-	int carry = 0;
+	return n;
+}
 
-	for (size_t i = 0; i < res.digits.size(); i++) {
-		int curr = digits[i] + carry * 10;
-		res.digits[i] = curr / 2;
-		carry = curr % 2;
+// умножение Карацубы: a * b = z2 * B^2k + (z1 - z0 - z2) * B^k + z0, res[0..na + nb) должен быть заполнен нулями
+// для очень длинных множителей используется быстрое преобразование (NTT)
+static void multKaratsuba(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* res) {
+	if (na < nb) {
+		std::swap(a, b);
+		std::swap(na, nb);
 	}
 
-	res.removeZeroes();
+	if (nb < LongInt::karatsubaThreshold || nb < 2) {
+		multSchool(a, na, b, nb, res);
+		return;
+	}
 
-	return res;
+	if (nb >= LongInt::nttThreshold && na + nb <= NTT_MAX_LENGTH) {
+		nttMultiply(a, na, b, nb, res);
+		return;
+	}
+
+	size_t k = (na + 1) / 2;
+
+	// сильно различающиеся по длине множители умножаются по частям длины nb
+	if (nb <= k) {
+		std::vector<uint32_t> part(2 * nb);
+
+		for (size_t i = 0; i < na; i += nb) {
+			size_t len = std::min(nb, na - i);
+
+			std::fill(part.begin(), part.end(), 0);
+			multKaratsuba(a + i, len, b, nb, part.data());
+			addRange(res + i, na + nb - i, part.data(), len + nb);
+		}
+
+		return;
+	}
+
+	// z0 = a0 * b0 и z2 = a1 * b1 сразу записываются на свои места в результате
+	multKaratsuba(a, k, b, k, res);
+	multKaratsuba(a + k, na - k, b + k, nb - k, res + 2 * k);
+
+	std::vector<uint32_t> sa(a, a + k), sb(b, b + k);
+
+	sa.push_back(0);
+	sb.push_back(0);
+	addRange(sa.data(), sa.size(), a + k, na - k);
+	addRange(sb.data(), sb.size(), b + k, nb - k);
+
+	size_t nsa = significantLength(sa.data(), sa.size());
+	size_t nsb = significantLength(sb.data(), sb.size());
+
+	// z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+	std::vector<uint32_t> z1(nsa + nsb, 0);
+
+	multKaratsuba(sa.data(), nsa, sb.data(), nsb, z1.data());
+	subRange(z1.data(), z1.size(), res, 2 * k);
+	subRange(z1.data(), z1.size(), res + 2 * k, na + nb - 2 * k);
+
+	addRange(res + k, na + nb - k, z1.data(), significantLength(z1.data(), z1.size()));
 }
 
-// конструктор по умолчанию (создаёт нулевое число)
-LongInt::LongInt() {
-	sign = 1;
-	digits = vector<int>(1, 0);
+// умножение модулей: столбиком для коротких чисел, методом Карацубы для длинных и через NTT для очень длинных
+vector<uint32_t> LongInt::multAbs(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+	vector<uint32_t> res(a.size() + b.size(), 0);
+
+	multKaratsuba(a.data(), a.size(), b.data(), b.size(), res.data());
+
+	return res;
 }
 
-LongInt::LongInt(long long v) {
-	sign = v < 0 ? -1 : 1;
-	v *= sign;
+// деление модуля на короткое число на месте, возвращает остаток
+// делители - степени двойки обрабатываются сдвигами вместо деления
+static uint32_t divShortAbs(vector<uint32_t>& a, uint32_t b) {
+	uint64_t rem = 0;
+
+	if ((b & (b - 1)) == 0) {
+		int shift = __builtin_ctz(b);
+
+		for (size_t i = a.size(); i > 0; i--) {
+			uint64_t curr = a[i - 1] + rem * LONG_INT_BASE;
+			a[i - 1] = curr >> shift;
+			rem = curr & (b - 1);
+		}
+
+		return rem;
+	}
+
+	for (size_t i = a.size(); i > 0; i--) {
+		uint64_t curr = a[i - 1] + rem * LONG_INT_BASE;
+		a[i - 1] = curr / b;
+		rem = curr % b;
+	}
+
+	return rem;
+}
 
-	long long tmp = v;
-	size_t len = 0;
+// деление модулей с остатком (алгоритм D Кнута), b не равно нулю
+void LongInt::divModAbs(const vector<uint32_t>& a, const vector<uint32_t>& b, vector<uint32_t>& q, vector<uint32_t>& r) {
+	if (compareAbs(a, b) < 0) {
+		q.assign(1, 0);
+		r = a;
+		return;
+	}
 
-	while (tmp) {
-		len++;
-		tmp /= 10;
+	if (b.size() == 1) {
+		q = a;
+		r.assign(1, divShortAbs(q, b[0]));
+		return;
 	}
 
-	if (len) {
-		digits = vector<int>(len, 0);
+	size_t n = b.size();
+	size_t m = a.size() - n;
+
+	// нормализация: после умножения на d старшая цифра делителя не меньше BASE / 2, и оценка qhat ошибается не более чем на 2
+	uint32_t d = LONG_INT_BASE / ((uint64_t) b.back() + 1);
+
+	vector<uint32_t> u(a.size() + 1, 0), v(n, 0), dv(1, d);
+
+	multSchool(a.data(), a.size(), dv.data(), 1, u.data());
+	multSchool(b.data(), n, dv.data(), 1, v.data());
+
+	q.assign(m + 1, 0);
+
+	for (size_t j = m + 1; j > 0; j--) {
+		size_t k = j - 1;
+
+		uint64_t num = (uint64_t) u[k + n] * LONG_INT_BASE + u[k + n - 1];
+		uint64_t qhat = num / v[n - 1];
+		uint64_t rhat = num % v[n - 1];
+
+		while (qhat >= LONG_INT_BASE || qhat * v[n - 2] > rhat * LONG_INT_BASE + u[k + n - 2]) {
+			qhat--;
+			rhat += v[n - 1];
+
+			if (rhat >= LONG_INT_BASE)
+				break;
+		}
+
+		// u[k..k + n] -= qhat * v
+		uint64_t carry = 0;
+		int64_t borrow = 0;
+
+		for (size_t i = 0; i < n; i++) {
+			uint64_t product = qhat * v[i] + carry;
+			carry = product / LONG_INT_BASE;
+
+			int64_t t = (int64_t) u[k + i] - (int64_t) (product % LONG_INT_BASE) - borrow;
+			borrow = t < 0;
+			u[k + i] = borrow ? t + LONG_INT_BASE : t;
+		}
+
+		int64_t top = (int64_t) u[k + n] - (int64_t) carry - borrow;
+
+		// qhat оказалось на единицу больше: возвращаем делитель обратно
+		if (top < 0) {
+			qhat--;
+
+			uint32_t c = 0;
 
-		size_t index = len - 1;
+			for (size_t i = 0; i < n; i++) {
+				uint32_t sum = u[k + i] + v[i] + c;
+				c = sum >= LONG_INT_BASE;
+				u[k + i] = c ? sum - LONG_INT_BASE : sum;
+			}
 
-		while (v) {
-			digits[index--] = v % 10;
-			v /= 10;
+			top += c;
 		}
+
+		u[k + n] = top;
+		q[k] = qhat;
 	}
-	else
-		digits = vector<int>(1, 0);
+
+	// остаток - младшие n цифр u, делённые на d
+	u.resize(n);
+	divShortAbs(u, d);
+	r.swap(u);
+}
+
+// ведущие нули запоминаются, чтобы число выводилось так же, как было записано
+void LongInt::readDigits(const string& s, size_t index) {
+	size_t end = index;
+
+	while (end < s.length() && s[end] >= '0' && s[end] <= '9')
+		end++;
+
+	size_t first = index;
+
+	while (first + 1 < end && s[first] == '0')
+		first++;
+
+	leadingZeros = first - index;
+	limbs.clear();
+
+	for (size_t i = end; i > first; ) {
+		size_t start = i > first + LONG_INT_BASE_DIGITS ? i - LONG_INT_BASE_DIGITS : first;
+		uint32_t limb = 0;
+
+		for (size_t j = start; j < i; j++)
+			limb = limb * 10 + (s[j] - '0');
+
+		limbs.push_back(limb);
+		i = start;
+	}
+
+	if (limbs.empty())
+		limbs.push_back(0);
+}
+
+// конструктор по умолчанию (создаёт нулевое число)
+LongInt::LongInt() {
+	sign = 1;
+	limbs = vector<uint32_t>(1, 0);
+	leadingZeros = 0;
+}
+
+LongInt::LongInt(long long value) {
+	sign = value < 0 ? -1 : 1;
+	leadingZeros = 0;
+
+	unsigned long long v = value < 0 ? 0 - (unsigned long long) value : value; // модуль числа (в том числе для LLONG_MIN)
+
+	do {
+		limbs.push_back(v % LONG_INT_BASE);
+		v /= LONG_INT_BASE;
+	} while (v);
 }
 
 LongInt::LongInt(const std::string& s) {
@@ -104,21 +341,23 @@ LongInt::LongInt(const std::string& s) {
 	else
 		sign = 1;
 
-	digits = vector<int>();
-	
-	while (index < s.length() && s[index] >= '0' && s[index] <= '9')
-		digits.push_back(s[index++] - '0');
-	
-	if (index < s.length() || s.length() == 0 || s == "-")
+	if (s.length() == 0 || s == "-" || s.find_first_not_of("0123456789", index) != string::npos)
 		throw string("LongInt(const string& s) - s is not valid integer number");
+
+	readDigits(s, index);
 }
 
 LongInt::LongInt(const LongInt& n) {
 	sign = n.sign;
-	digits = vector<int>(n.digits.size());
+	limbs = n.limbs;
+	leadingZeros = n.leadingZeros;
+}
+
+LongInt::LongInt(const vector<uint32_t>& limbs, bool negative) {
+	this->sign = negative ? -1 : 1;
+	this->limbs = limbs.empty() ? vector<uint32_t>(1, 0) : limbs;
 
-	for (size_t i = 0; i < n.digits.size(); i++)
-		digits[i] = n.digits[i];
+	removeZeroes();
 }
 
 
@@ -126,42 +365,22 @@ bool LongInt::operator>(const LongInt& n) const {
 	if (sign != n.sign)
 		return sign > n.sign;
 
-	if (digits.size() != n.digits.size())
-		return (digits.size() > n.digits.size()) ^ (sign == -1);
+	int cmp = compareAbs(limbs, n.limbs);
 
-	for (size_t i = 0; i < digits.size(); i++)
-		if (digits[i] != n.digits[i])
-			return (digits[i] > n.digits[i]) ^ (sign == -1);
-	
-	return false;
+	return sign == 1 ? cmp > 0 : cmp < 0;
 }
 
 bool LongInt::operator<(const LongInt& n) const {
 	if (sign != n.sign)
 		return sign < n.sign;
 
-	if (digits.size() != n.digits.size())
-		return (digits.size() < n.digits.size()) ^ (sign == -1);
+	int cmp = compareAbs(limbs, n.limbs);
 
-	for (size_t i = 0; i < digits.size(); i++)
-		if (digits[i] != n.digits[i])
-			return (digits[i] < n.digits[i]) ^ (sign == -1);
-	
-	return false;
+	return sign == 1 ? cmp < 0 : cmp > 0;
 }
 
 bool LongInt::operator==(const LongInt& n) const {
-	if (sign != n.sign)
-		return false;
-
-	if (digits.size() != n.digits.size())
-		return false;
-
-	for (size_t i = 0; i < digits.size(); i++)
-		if (digits[i] != n.digits[i])
-			return false;
-	
-	return true;
+	return sign == n.sign && compareAbs(limbs, n.limbs) == 0;
 }
 
 bool LongInt::operator!=(const LongInt& n) const {
@@ -169,11 +388,11 @@ bool LongInt::operator!=(const LongInt& n) const {
 }
 
 bool LongInt::operator>=(const LongInt& n) const {
-	return (*this > n) || (*this == n);
+	return !(*this < n);
 }
 
 bool LongInt::operator<=(const LongInt& n) const {
-	return (*this < n) || (*this == n);
+	return !(*this > n);
 }
 
 
@@ -182,10 +401,8 @@ LongInt& LongInt::operator=(const LongInt& n) {
 		return *this;
 
 	sign = n.sign;
-	digits = vector<int>(n.digits.size());
-
-	for (size_t i = 0; i < n.digits.size(); i++)
-		digits[i] = n.digits[i];
+	limbs = n.limbs; // reuses allocated memory
+	leadingZeros = n.leadingZeros;
 
 	return *this;
 }
@@ -199,156 +416,119 @@ LongInt LongInt::operator-() const {
 
 
 LongInt LongInt::operator+(const LongInt& n) const {
-	if (sign == n.sign) { // если знаки одинаковые, то выполняем сложение
-		size_t len = 1 + max(digits.size(), n.digits.size());
-
-		LongInt res;
+	LongInt res;
 
+	if (sign == n.sign) { // если знаки одинаковые, то выполняем сложение модулей
+		res.limbs = limbs;
 		res.sign = sign;
-		res.digits = vector<int>(len);
-
-		for (int i = digits.size() - 1; i >= 0; i--)
-			res.digits[len - digits.size() + i] = digits[i];
-
-		for (int i = n.digits.size() - 1; i >= 0; i--)
-			res.digits[len - n.digits.size() + i] += n.digits[i];
-
-		for (size_t i = len - 1; i > 0; i--) {
-			res.digits[i - 1] += res.digits[i] / 10;
-			res.digits[i] %= 10;
-		}
-
-		res.removeZeroes();
-
-		return res;
+		addAbs(res.limbs, n.limbs);
+	}
+	else if (compareAbs(limbs, n.limbs) >= 0) {
+		res.limbs = limbs;
+		res.sign = sign;
+		subAbs(res.limbs, n.limbs);
+	}
+	else {
+		res.limbs = n.limbs;
+		res.sign = n.sign;
+		subAbs(res.limbs, limbs);
 	}
 
-	if (sign == -1)
-		return n - (-(*this));
-	
-	return *this - (-n);
+	res.removeZeroes();
+
+	return res;
 }
 
 LongInt LongInt::operator-(const LongInt& n) const {
-	if (sign == 1 && n.sign == 1) { // если оба числа положительны
-		size_t len = 1 + max(digits.size(), n.digits.size());
-		bool cmp = *this > n;
-
-		LongInt a(cmp ? *this : n);
-		LongInt b(cmp ? n : *this);
-		LongInt res;
-
-		res.sign = cmp ? 1 : -1;
-		res.digits = vector<int>(len);
-
-		for (int i = a.digits.size() - 1; i >= 0; i--)
-			res.digits[len - a.digits.size() + i] = a.digits[i];
-
-		for (int i = b.digits.size() - 1; i >= 0; i--)
-			res.digits[len - b.digits.size() + i] -= b.digits[i];
-
-		for (size_t i = len - 1; i > 0; i--) {
-			if (res.digits[i] < 0) {
-				res.digits[i] += 10;
-				res.digits[i - 1]--;
-			}
-		}
-
-		res.removeZeroes();
+	LongInt res;
 
-		return res;
+	if (sign != n.sign) { // если знаки разные, то выполняем сложение модулей
+		res.limbs = limbs;
+		res.sign = sign;
+		addAbs(res.limbs, n.limbs);
+	}
+	else if (compareAbs(limbs, n.limbs) >= 0) {
+		res.limbs = limbs;
+		res.sign = sign;
+		subAbs(res.limbs, n.limbs);
+	}
+	else {
+		res.limbs = n.limbs;
+		res.sign = -sign;
+		subAbs(res.limbs, limbs);
 	}
 
-	if (sign == -1 && n.sign == -1)
-		return (-n) - (-(*this));
-	
-	return *this + (-n);
+	res.removeZeroes();
+
+	return res;
 }
 
 LongInt LongInt::operator*(const LongInt& n) const {
-	size_t len = 1 + digits.size() + n.digits.size();
 	LongInt res;
 
 	res.sign = sign * n.sign;
-	res.digits = vector<int>(len, 0);
-
-	for (size_t i = 0; i < digits.size(); i++)
-		for (size_t j = 0; j < n.digits.size(); j++)
-			res.digits[len - 1 - i - j] += digits[digits.size() - 1 - i] * n.digits[n.digits.size() - 1 - j];
-	
-	for (size_t i = len - 1; i > 0; i--) {
-		res.digits[i - 1] += res.digits[i] / 10;
-		res.digits[i] %= 10;
-	}
-
+	res.limbs = multAbs(limbs, n.limbs);
 	res.removeZeroes();
 
 	return res;
 }
 
-LongInt LongInt::operator/(const LongInt& n) const {
-	LongInt z = 1;
-
-	LongInt mod(*this);
-	LongInt b(n);
-
-	mod.sign = 1;
-	b.sign = 1;
-
-	long long k = 0;
+void LongInt::divMod(const LongInt& n, LongInt& quotient, LongInt& remainder) const {
+	if (n.limbs.size() == 1 && n.limbs[0] == 0)
+		throw string("LongInt::divMod - division by zero");
 
-	while (mod >= b) {
-		b = b.mult2();
-		z = z.mult2();
-		k++;
-	}
+	vector<uint32_t> q, r;
+	int qSign = sign * n.sign;
+	int rSign = sign;
 
-	LongInt div;
+	divModAbs(limbs, n.limbs, q, r);
 
-	while (k > 0) {
-		b = b.div2();
-		z = z.div2();
-		k--;
+	quotient.sign = qSign;
+	quotient.limbs.swap(q);
+	quotient.removeZeroes();
 
-		if (mod >= b) {
-			mod = mod - b;
-			div = div + z;
-		}
-	}
+	remainder.sign = rSign;
+	remainder.limbs.swap(r);
+	remainder.removeZeroes();
+}
 
-	div.sign = sign * n.sign;
-	div.removeZeroes();
+// деление на месте на короткое число 0 < n < 10^9, возвращает остаток от деления модуля
+uint32_t LongInt::divShort(uint32_t n) {
+	uint32_t rem = n == 1 ? 0 : divShortAbs(limbs, n);
+	removeZeroes();
 
-	return div;
+	return rem;
 }
 
-LongInt LongInt::operator%(const LongInt& n) const {
-	LongInt mod(*this);
-	LongInt b(n);
+// остаток от деления модуля на короткое число 0 < n < 10^9 без вычисления частного
+uint32_t LongInt::modShort(uint32_t n) const {
+	// 10^9 делится на n (2, 4, ..., 512, 10, 1000, ...): остаток определяется младшей цифрой
+	if ((n & (n - 1)) == 0 && n <= 512)
+		return limbs[0] & (n - 1);
 
-	mod.sign = 1;
-	b.sign = 1;
+	if (LONG_INT_BASE % n == 0)
+		return limbs[0] % n;
 
-	long long k = 0;
+	uint64_t rem = 0;
 
-	while (mod >= b) {
-		b = b.mult2();
-		k++;
-	}
+	for (size_t i = limbs.size(); i > 0; i--)
+		rem = (limbs[i - 1] + rem * LONG_INT_BASE) % n;
 
-	while (k > 0) {
-		b = b.div2();
+	return rem;
+}
 
-		k--;
+LongInt LongInt::operator/(const LongInt& n) const {
+	LongInt quotient, remainder;
+	divMod(n, quotient, remainder);
 
-		if (mod >= b)
-			mod = mod - b;
-	}
+	return quotient;
+}
 
-	mod.sign = sign;
-	mod.removeZeroes();
+LongInt LongInt::operator%(const LongInt& n) const {
+	LongInt quotient, remainder;
+	divMod(n, quotient, remainder);
 
-	return mod;
+	return remainder;
 }
 
 
@@ -395,12 +575,33 @@ LongInt& LongInt::operator--() {
 	return (*this -= 1);
 }
 
+bool LongInt::isZero() const {
+	return limbs.size() == 1 && limbs[0] == 0;
+}
+
+bool LongInt::isNegative() const {
+	return sign == -1;
+}
+
 bool LongInt::isEven() const {
-	return digits[digits.size() - 1] % 2 == 0;
+	return limbs[0] % 2 == 0;
 }
 
 bool LongInt::isOdd() const {
-	return digits[digits.size() - 1] % 2 == 1;
+	return limbs[0] % 2 == 1;
+}
+
+size_t LongInt::digitsCount() const {
+	size_t count = leadingZeros + (limbs.size() - 1) * LONG_INT_BASE_DIGITS;
+
+	for (uint32_t top = limbs.back(); top >= 10; top /= 10)
+		count++;
+
+	return count + 1;
+}
+
+const vector<uint32_t>& LongInt::getLimbs() const {
+	return limbs;
 }
 
 LongInt LongInt::factorial() const {
@@ -415,14 +616,50 @@ LongInt LongInt::factorial() const {
 	return fact;
 }
 
+bool LongInt::toLongLong(long long& value) const {
+	if (leadingZeros)
+		return false;
+
+	if (sign == -1 && limbs.size() == 1 && limbs[0] == 0)
+		return false; // отрицательный ноль
+
+	unsigned long long res = 0;
+
+	for (size_t i = limbs.size(); i > 0; i--) {
+		if (res > (ULLONG_MAX - limbs[i - 1]) / LONG_INT_BASE)
+			return false;
+
+		res = res * LONG_INT_BASE + limbs[i - 1];
+	}
+
+	if (sign == 1 && res > (unsigned long long) LLONG_MAX)
+		return false;
+
+	if (sign == -1 && res > (unsigned long long) LLONG_MAX + 1)
+		return false;
+
+	value = sign == 1 ? (long long) res : (long long) (0 - res);
+
+	return true;
+}
+
 string LongInt::toString() const {
 	string s;
 
+	s.reserve(digitsCount() + 1);
+
 	if (sign == -1)
 		s += '-';
 
-	for (size_t i = 0; i < digits.size(); i++)
-		s += to_string(digits[i]);
+	s.append(leadingZeros, '0');
+	s += to_string(limbs.back());
+
+	char buffer[LONG_INT_BASE_DIGITS + 1];
+
+	for (size_t i = limbs.size() - 1; i > 0; i--) {
+		snprintf(buffer, sizeof(buffer), "%09u", limbs[i - 1]);
+		s += buffer;
+	}
 
 	return s;
 }
@@ -430,7 +667,7 @@ string LongInt::toString() const {
 // ввод из потока
 istream& operator>>(istream &fs, LongInt &n) {
 	char c;
-	n.digits = vector<int>(0);
+	string digits;
 
 	fs.get(c);
 
@@ -445,20 +682,16 @@ istream& operator>>(istream &fs, LongInt &n) {
 		n.sign = 1;
 
 	while (fs && c >= '0' && c <= '9') {
-		n.digits.push_back(c - '0');
+		digits += c;
 		fs.get(c);
 	}
 
+	n.readDigits(digits, 0);
+
 	return fs;
 }
 
 // вывод в поток
 ostream& operator<<(ostream &fs, const LongInt &n) {
-	if (n.sign == -1)
-		fs << '-';
-
-	for (size_t i = 0; i < n.digits.size(); i++)
-		fs << n.digits[i];
-	
-	return fs;
-}
\ No newline at end of file
+	return fs << n.toString();
+}
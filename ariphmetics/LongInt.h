@@ -1,20 +1,42 @@
+#ifndef LONG_INT_H
+#define LONG_INT_H
+
 #include <iostream>
+#include <climits>
+#include <cstdint>
 #include <vector>
 #include <string>
 
+#define LONG_INT_BASE 1000000000 // основание системы счисления (10^9)
+#define LONG_INT_BASE_DIGITS 9 // количество десятичных цифр в одной цифре числа
+#define LONG_INT_KARATSUBA_THRESHOLD 48 // длина (в цифрах по основанию 10^9), начиная с которой используется умножение Карацубы
+// (longIntBenchmark на x86-64 Xeon, g++ 12 -O3: пороги 24-64 отличаются в пределах 2-3%, чаще всего лучший - 48)
+#define LONG_INT_NTT_THRESHOLD 2048 // длина, начиная с которой используется умножение через NTT
+
 class LongInt {
 	int sign; // знак числа: 1 - положительное, -1 - отрицательное
-	std::vector<int> digits; // вектор цифр
+	std::vector<uint32_t> limbs; // цифры числа по основанию 10^9, начиная с младшей
+	size_t leadingZeros; // количество ведущих нулей в записи числа (сохраняются при вводе, например 007)
 
 	void removeZeroes(); // удаление незначащих нулей
-	LongInt mult2() const; // умножение на 2
-	LongInt div2() const; // деление на 2
+
+	static int compareAbs(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b); // сравнение модулей
+	static void addAbs(std::vector<uint32_t>& a, const std::vector<uint32_t>& b); // a += b для модулей
+	static void subAbs(std::vector<uint32_t>& a, const std::vector<uint32_t>& b); // a -= b для модулей (a >= b)
+	static std::vector<uint32_t> multAbs(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b); // произведение модулей
+	static void divModAbs(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::vector<uint32_t>& q, std::vector<uint32_t>& r); // частное и остаток модулей
+
+	void readDigits(const std::string& s, size_t index); // разбор десятичной записи модуля начиная с позиции index
 
 public:
+	static size_t karatsubaThreshold; // порог перехода к умножению Карацубы (подбирается longIntBenchmark)
+	static size_t nttThreshold; // порог перехода к умножению через NTT (подбирается longIntBenchmark)
+
 	LongInt();
 	LongInt(long long v);
 	LongInt(const std::string& s);
 	LongInt(const LongInt& n);
+	LongInt(const std::vector<uint32_t>& limbs, bool negative); // число из цифр модуля по основанию 10^9 (начиная с младшей) и знака
 
 	LongInt& operator=(const LongInt& n); // оператор присваивания
 
@@ -33,6 +55,10 @@ public:
 	LongInt operator/(const LongInt& n) const; // деление двух чисел
 	LongInt operator%(const LongInt& n) const; // остаток от деления двух чисел
 
+	void divMod(const LongInt& n, LongInt& quotient, LongInt& remainder) const; // частное и остаток за одно деление
+	uint32_t divShort(uint32_t n); // деление модуля на короткое число (0 < n < 10^9) на месте, возвращает остаток
+	uint32_t modShort(uint32_t n) const; // остаток от деления модуля на короткое число (0 < n < 10^9)
+
 	LongInt& operator+=(const LongInt& n); // сложение двух чисел (краткая форма)
 	LongInt& operator-=(const LongInt& n); // вычитание двух чисел (краткая форма)
 	LongInt& operator*=(const LongInt& n); // умножение двух чисел (краткая форма)
@@ -45,13 +71,22 @@ public:
 	LongInt& operator++(); // префиксная форма инкремента
 	LongInt& operator--(); // префиксная форма декремента
 
+	bool isZero() const; // проверка на ноль (в том числе -0)
+	bool isNegative() const; // проверка на отрицательность (в том числе -0)
 	bool isEven() const; // проверка на чётность
 	bool isOdd() const; // проверка на нечётность
 
+	size_t digitsCount() const; // количество цифр числа
+	const std::vector<uint32_t>& getLimbs() const; // цифры модуля по основанию 10^9, начиная с младшей
+
 	LongInt factorial() const; // факториал числа
 
+	bool toLongLong(long long& value) const; // преобразование в long long (false, если число не помещается или записано не канонически)
+
 	std::string toString() const;
 
 	friend std::istream& operator>>(std::istream &fs, LongInt &n);
 	friend std::ostream& operator<<(std::ostream &fs, const LongInt &n);
-};
\ No newline at end of file
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "NTT.h"
+
+#include <vector>
+
+using namespace std;
+
+// primes p = c * 2^k + 1 with primitive root 3, product of all three is about 7.9e25,
+// so convolution of up to 2^23 digits below 10^9 is reconstructed exactly
+const uint32_t P1 = 998244353;
+const uint32_t P2 = 167772161;
+const uint32_t P3 = 469762049;
+const uint32_t ROOT = 3;
+
+static uint32_t powMod(uint64_t a, uint64_t e, uint32_t p) {
+	uint64_t res = 1;
+	a %= p;
+
+	while (e) {
+		if (e & 1)
+			res = res * a % p;
+
+		a = a * a % p;
+		e >>= 1;
+	}
+
+	return res;
+}
+
+static void transform(vector<uint32_t>& a, bool invert, uint32_t p) {
+	size_t n = a.size();
+
+	for (size_t i = 1, j = 0; i < n; i++) {
+		size_t bit = n >> 1;
+
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+
+		j ^= bit;
+
+		if (i < j)
+			swap(a[i], a[j]);
+	}
+
+	vector<uint32_t> roots(n / 2);
+
+	for (size_t len = 2; len <= n; len <<= 1) {
+		uint64_t w = powMod(ROOT, (p - 1) / len, p);
+
+		if (invert)
+			w = powMod(w, p - 2, p);
+
+		size_t half = len / 2;
+		roots[0] = 1;
+
+		for (size_t i = 1; i < half; i++)
+			roots[i] = roots[i - 1] * w % p;
+
+		for (size_t i = 0; i < n; i += len) {
+			for (size_t j = 0; j < half; j++) {
+				uint32_t u = a[i + j];
+				uint32_t v = (uint64_t) a[i + j + half] * roots[j] % p;
+
+				a[i + j] = u + v >= p ? u + v - p : u + v;
+				a[i + j + half] = u >= v ? u - v : u + p - v;
+			}
+		}
+	}
+
+	if (invert) {
+		uint64_t inv = powMod(n, p - 2, p);
+
+		for (size_t i = 0; i < n; i++)
+			a[i] = a[i] * inv % p;
+	}
+}
+
+// cyclic convolution of a and b modulo p, n is power of two
+static vector<uint32_t> convolution(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, size_t n, uint32_t p) {
+	vector<uint32_t> fa(n, 0), fb(n, 0);
+
+	for (size_t i = 0; i < na; i++)
+		fa[i] = a[i] % p;
+
+	for (size_t i = 0; i < nb; i++)
+		fb[i] = b[i] % p;
+
+	transform(fa, false, p);
+	transform(fb, false, p);
+
+	for (size_t i = 0; i < n; i++)
+		fa[i] = (uint64_t) fa[i] * fb[i] % p;
+
+	transform(fa, true, p);
+
+	return fa;
+}
+
+void nttMultiply(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* res) {
+	size_t n = 1;
+
+	while (n < na + nb)
+		n <<= 1;
+
+	vector<uint32_t> r1 = convolution(a, na, b, nb, n, P1);
+	vector<uint32_t> r2 = convolution(a, na, b, nb, n, P2);
+	vector<uint32_t> r3 = convolution(a, na, b, nb, n, P3);
+
+	const uint64_t inv1 = powMod(P1, P2 - 2, P2); // P1^-1 mod P2
+	const uint64_t inv12 = powMod((uint64_t) P1 * P2 % P3, P3 - 2, P3); // (P1 * P2)^-1 mod P3
+	const uint64_t p12 = (uint64_t) P1 * P2;
+	const uint64_t p12Low = p12 % NTT_BASE;
+	const uint64_t p12High = p12 / NTT_BASE;
+
+	uint64_t carry = 0;
+
+	for (size_t i = 0; i < na + nb; i++) {
+		// Garner's algorithm: value = x1 + x2 * P1 + x3 * P1 * P2
+		uint64_t x1 = r1[i];
+		uint64_t x2 = (r2[i] + P2 - x1 % P2) % P2 * inv1 % P2;
+		uint64_t x12 = x1 + x2 * P1;
+		uint64_t x3 = (r3[i] + P3 - x12 % P3) % P3 * inv12 % P3;
+
+		// value = low + high * 10^9 without 128-bit arithmetic
+		uint64_t t = x12 + x3 * p12Low;
+		uint64_t low = t % NTT_BASE;
+		uint64_t high = t / NTT_BASE + x3 * p12High;
+
+		uint64_t sum = low + carry;
+		res[i] = sum % NTT_BASE;
+		carry = sum / NTT_BASE + high;
+	}
+}
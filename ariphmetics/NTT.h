@@ -0,0 +1,15 @@
+#ifndef NTT_H
+#define NTT_H
+
+#include <cstdint>
+#include <cstddef>
+
+#define NTT_BASE 1000000000 // base of digits of multiplied numbers
+#define NTT_MAX_LENGTH (1 << 23) // max length of transform (limited by 998244353 = 119 * 2^23 + 1)
+
+// exact product of numbers a[0..na) and b[0..nb) with base 10^9 digits (least significant first)
+// convolution is calculated modulo three primes and reconstructed by chinese remainder theorem
+// res[0..na + nb) is overwritten, na + nb must not exceed NTT_MAX_LENGTH
+void nttMultiply(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* res);
+
+#endif
@@ -0,0 +1,290 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <climits>
+
+#include "../ariphmetics/LongInt.h"
+#include "../ariphmetics/LongDouble.h"
+
+using namespace std;
+
+// случайное число из digits десятичных цифр
+LongInt randomLongInt(mt19937_64& generator, size_t digits) {
+	string s(digits, '0');
+
+	s[0] = '1' + generator() % 9;
+
+	for (size_t i = 1; i < digits; i++)
+		s[i] = '0' + generator() % 10;
+
+	return LongInt(s);
+}
+
+#define BENCHMARK_ROUNDS 5 // количество замеров, из которых берётся наименьший (отсекает помехи от других процессов)
+
+// среднее время одного умножения в микросекундах (лучшее из BENCHMARK_ROUNDS замеров)
+double measure(const LongInt& a, const LongInt& b, size_t karatsubaThreshold, size_t nttThreshold, LongInt& product) {
+	LongInt::karatsubaThreshold = karatsubaThreshold;
+	LongInt::nttThreshold = nttThreshold;
+
+	double best = 0;
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		int repeats = 0;
+		auto start = chrono::steady_clock::now();
+		double elapsed = 0;
+
+		do {
+			product = a * b;
+			repeats++;
+			elapsed = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+		} while (elapsed < 50000);
+
+		if (!round || elapsed / repeats < best)
+			best = elapsed / repeats;
+	}
+
+	return best;
+}
+
+// подбор порога умножения Карацубы (NTT отключено)
+size_t benchmarkKaratsuba(mt19937_64& generator) {
+	vector<size_t> sizes = { 16, 32, 64, 128, 256, 512, 1024, 2048 }; // длины множителей в цифрах по основанию 10^9
+	vector<size_t> thresholds = { 8, 16, 24, 32, 48, 64, 96, 128 };
+
+	cout << setw(8) << "limbs" << setw(14) << "schoolbook";
+
+	for (size_t j = 0; j < thresholds.size(); j++)
+		cout << setw(12) << ("k" + to_string(thresholds[j]));
+
+	cout << endl;
+
+	vector<double> totals(thresholds.size(), 0);
+
+	for (size_t i = 0; i < sizes.size(); i++) {
+		LongInt a = randomLongInt(generator, sizes[i] * LONG_INT_BASE_DIGITS);
+		LongInt b = randomLongInt(generator, sizes[i] * LONG_INT_BASE_DIGITS);
+		LongInt expected, product;
+
+		double school = measure(a, b, SIZE_MAX, SIZE_MAX, expected);
+
+		cout << setw(8) << sizes[i] << setw(14) << fixed << setprecision(1) << school;
+
+		for (size_t j = 0; j < thresholds.size(); j++) {
+			double time = measure(a, b, thresholds[j], SIZE_MAX, product);
+
+			if (product != expected) {
+				cout << endl << "product mismatch for " << sizes[i] << " limbs, threshold " << thresholds[j] << endl;
+				return 0;
+			}
+
+			totals[j] += time / school; // относительное время, чтобы большие длины не заглушали малые
+			cout << setw(12) << time;
+		}
+
+		cout << endl;
+	}
+
+	size_t best = 0;
+
+	cout << setw(22) << "relative total";
+
+	for (size_t j = 0; j < thresholds.size(); j++) {
+		cout << setw(12) << setprecision(2) << totals[j];
+
+		if (totals[j] < totals[best])
+			best = j;
+	}
+
+	cout << endl;
+	cout << "best Karatsuba threshold: " << thresholds[best] << " limbs (LONG_INT_KARATSUBA_THRESHOLD = " << LONG_INT_KARATSUBA_THRESHOLD << ")" << endl << endl;
+
+	return thresholds[best];
+}
+
+// подбор порога умножения через NTT: наименьшая длина, с которой NTT быстрее Карацубы
+size_t benchmarkNTT(mt19937_64& generator, size_t karatsubaThreshold) {
+	vector<size_t> sizes = { 128, 256, 512, 1024, 2048, 4096, 8192, 16384 };
+
+	cout << setw(8) << "limbs" << setw(14) << "karatsuba" << setw(14) << "ntt" << endl;
+
+	size_t best = 0;
+
+	for (size_t i = 0; i < sizes.size(); i++) {
+		LongInt a = randomLongInt(generator, sizes[i] * LONG_INT_BASE_DIGITS);
+		LongInt b = randomLongInt(generator, sizes[i] * LONG_INT_BASE_DIGITS);
+		LongInt expected, product;
+
+		double karatsuba = measure(a, b, karatsubaThreshold, SIZE_MAX, expected);
+		double ntt = measure(a, b, karatsubaThreshold, 0, product);
+
+		if (product != expected) {
+			cout << "product mismatch for " << sizes[i] << " limbs" << endl;
+			return 0;
+		}
+
+		cout << setw(8) << sizes[i] << setw(14) << fixed << setprecision(1) << karatsuba << setw(14) << ntt << endl;
+
+		if (ntt < karatsuba && !best)
+			best = sizes[i];
+		else if (ntt >= karatsuba)
+			best = 0;
+	}
+
+	if (!best)
+		best = SIZE_MAX;
+
+	cout << "best NTT threshold: " << best << " limbs (LONG_INT_NTT_THRESHOLD = " << LONG_INT_NTT_THRESHOLD << ")" << endl << endl;
+
+	return best;
+}
+
+// сравнение Карацубы и NTT со столбиком на случайных множителях разной длины
+bool crossCheck(mt19937_64& generator, int count) {
+	for (int i = 0; i < count; i++) {
+		size_t digitsA = 1 + generator() % 20000;
+		size_t digitsB = i % 4 == 0 ? 1 + generator() % 100 : 1 + generator() % 20000;
+
+		LongInt a = i % 10 == 0 ? LongInt(string(digitsA, '9')) : randomLongInt(generator, digitsA); // максимальные цифры дают максимальные свёртки
+		LongInt b = i % 10 == 0 ? -LongInt(string(digitsB, '9')) : randomLongInt(generator, digitsB);
+
+		LongInt::karatsubaThreshold = SIZE_MAX;
+		LongInt::nttThreshold = SIZE_MAX;
+		LongInt expected = a * b;
+
+		LongInt::karatsubaThreshold = 2;
+		LongInt karatsuba = a * b;
+
+		LongInt::nttThreshold = 0;
+		LongInt ntt = a * b;
+
+		if (karatsuba != expected || ntt != expected) {
+			cout << "cross-check failed for " << digitsA << " x " << digitsB << " digits" << endl;
+			return false;
+		}
+
+		// мантиссы LongDouble длиннее LONG_DOUBLE_NTT_THRESHOLD тоже умножаются через NTT
+		if (i % 4 == 1 && (LongDouble(a.toString()) * LongDouble(b.toString())).toString() != expected.toString()) {
+			cout << "LongDouble cross-check failed for " << digitsA << " x " << digitsB << " digits" << endl;
+			return false;
+		}
+	}
+
+	cout << "cross-check: " << count << " random products are equal to schoolbook ones" << endl;
+
+	return true;
+}
+
+// случайное число из limbs цифр по основанию 10^9, цифры чаще всего граничные (0, 1, BASE / 2, BASE - 1 и соседние)
+LongInt randomLimbs(mt19937_64& generator, size_t limbs, bool negative) {
+	const uint32_t edges[] = { 0, 1, LONG_INT_BASE / 2 - 1, LONG_INT_BASE / 2, LONG_INT_BASE / 2 + 1, LONG_INT_BASE - 2, LONG_INT_BASE - 1 };
+	vector<uint32_t> digits(limbs);
+
+	for (size_t i = 0; i < limbs; i++)
+		digits[i] = generator() % 3 ? edges[generator() % 7] : generator() % LONG_INT_BASE;
+
+	if (!digits.back())
+		digits.back() = 1 + generator() % (LONG_INT_BASE - 1);
+
+	return LongInt(digits, negative);
+}
+
+LongInt absLongInt(const LongInt& n) {
+	return n.isNegative() ? -n : n;
+}
+
+// проверка определения деления с отбрасыванием дробной части: a = q * b + r, |r| < |b|, знак r совпадает со знаком a
+bool checkDivision(const LongInt& a, const LongInt& b) {
+	LongInt q, r;
+	a.divMod(b, q, r);
+
+	bool correct = q * b + r == a && absLongInt(r) < absLongInt(b) && (r.isZero() || r.isNegative() == a.isNegative()) && a / b == q && a % b == r;
+
+	if (!correct)
+		cout << "division cross-check failed for " << a << " / " << b << endl;
+
+	return correct;
+}
+
+// деление по алгоритму D на случайных делимых и делителях разной длины и знака
+bool divisionCrossCheck(mt19937_64& generator, int count) {
+	// делимые и делители, при делении которых оценка qhat оказывается на единицу больше и делитель прибавляется обратно
+	const char* addBack[][2] = {
+		{ "999999998999999998999999998499999999499999999", "999999999999999998999999998" },
+		{ "499999999000000000000000000999999999", "499999999000000000377770579" },
+		{ "999999999000000001000000000500000000", "499999999500000000999999998" },
+		{ "999999998000000001999999999999999998999999998000000000", "999999999000000001999999998" }
+	};
+
+	for (size_t i = 0; i < sizeof(addBack) / sizeof(addBack[0]); i++)
+		for (int signs = 0; signs < 4; signs++)
+			if (!checkDivision(signs & 1 ? -LongInt(addBack[i][0]) : LongInt(addBack[i][0]), signs & 2 ? -LongInt(addBack[i][1]) : LongInt(addBack[i][1])))
+				return false;
+
+	for (int i = 0; i < count; i++) {
+		size_t limbsB = 1 + generator() % (i % 4 == 0 ? 3 : 100);
+		size_t limbsA = i % 8 == 0 ? 1 + generator() % limbsB : limbsB + generator() % 100; // делимое иногда короче делителя
+
+		LongInt a = randomLimbs(generator, limbsA, generator() % 2);
+		LongInt b = randomLimbs(generator, limbsB, generator() % 2);
+
+		if (!checkDivision(a, b) || !checkDivision(b * a + (generator() % 2 ? b - 1 : LongInt(0)), b))
+			return false;
+	}
+
+	cout << "division cross-check: " << count << " random pairs satisfy a = q * b + r" << endl;
+
+	return true;
+}
+
+// деление на короткое число: сдвиг для степеней двойки, младшая цифра для делителей 10^9, общий случай
+bool shortDivisionCrossCheck(mt19937_64& generator, int count) {
+	vector<uint32_t> divisors = { 1, 5, 10, 1000, 1953125, 500000000, 999999937, 999999999 };
+
+	for (uint32_t n = 2; n < LONG_INT_BASE; n *= 2)
+		divisors.push_back(n);
+
+	for (int i = 0; i < count; i++) {
+		uint32_t n = i % 2 ? divisors[generator() % divisors.size()] : 1 + generator() % (LONG_INT_BASE - 1);
+		LongInt a = randomLimbs(generator, 1 + generator() % 50, generator() % 2);
+		LongInt q = a;
+		uint32_t rem = q.divShort(n);
+
+		bool correct = absLongInt(q) * LongInt(n) + LongInt(rem) == absLongInt(a) && rem < n &&
+			(q.isZero() || q.isNegative() == a.isNegative()) && a.modShort(n) == rem;
+
+		if (!correct) {
+			cout << "short division cross-check failed for " << a << " / " << n << endl;
+			return false;
+		}
+	}
+
+	cout << "short division cross-check: " << count << " random dividends satisfy |a| = |q| * n + r" << endl;
+
+	return true;
+}
+
+int main() {
+	mt19937_64 generator(42);
+
+	if (!crossCheck(generator, 200))
+		return 1;
+
+	if (!divisionCrossCheck(generator, 2000) || !shortDivisionCrossCheck(generator, 20000))
+		return 1;
+
+	size_t karatsubaThreshold = benchmarkKaratsuba(generator);
+
+	if (!karatsubaThreshold)
+		return 1;
+
+	if (!benchmarkNTT(generator, karatsubaThreshold))
+		return 1;
+
+	cout << "time in microseconds per multiplication" << endl;
+
+	return 0;
+}
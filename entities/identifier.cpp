@@ -2,11 +2,12 @@
 
 using namespace std;
 
-Identifier::Identifier(IdentifierT type, const string& name, const string& value, bool declared) {
+Identifier::Identifier(IdentifierT type, const string& name, const Value& value, bool declared) {
 	this->type = type;
 	this->name = name;
 	this->value = value;
 	this->isDeclared = declared;
+	this->slot = -1;
 }
 
 const string& Identifier::getName() {
@@ -17,31 +18,34 @@ void Identifier::setName(const string& name) {
 	this->name = name;
 }
 
-const string& Identifier::getValue() {
+Value& Identifier::getValue() {
 	return value;
 }
 
-void Identifier::setValue(const string& value) {
+void Identifier::setValue(const Value& value) {
 	this->value = value;
 }
 
 void Identifier::setDefaultValue() {
 	switch (type) {
 		case IdentifierT::identifier_int:
+			value = Value(Integer());
+			break;
+
 		case IdentifierT::identifier_real:
-			value = "0";
+			value = Value(LongDouble());
 			break;
 
 		case IdentifierT::identifier_boolean:
-			value = LEX_FALSE;
+			value = Value(false);
 			break;
 
 		case IdentifierT::identifier_string:
-			value.clear();
+			value = Value(string());
 			break;
 
 		default:
-			value.clear();
+			value = Value();
 			break;
 	}
 }
@@ -62,6 +66,14 @@ void Identifier::setDeclared(bool declared) {
 	this->isDeclared = declared;
 }
 
+int Identifier::getSlot() const {
+	return slot;
+}
+
+void Identifier::setSlot(int slot) {
+	this->slot = slot;
+}
+
 LexemeT Identifier::toConstantLexemeT() const {
 	switch (type) {
 		case IdentifierT::identifier_int:
@@ -6,24 +6,26 @@
 #include <cstdio>
 
 #include "lexeme.h"
+#include "value.h"
 #include "../enums.h"
 #include "../colors.h"
 
 class Identifier {
 	std::string name;
-	std::string value;
+	Value value;
 	IdentifierT type;
 
 	bool isDeclared;
+	int slot; // index of variable at runtime (-1 if identifier isn't declared)
 
 public:
-	Identifier(IdentifierT type, const std::string& name, const std::string& value = "", bool isDeclared = false);
+	Identifier(IdentifierT type, const std::string& name, const Value& value = Value(), bool isDeclared = false);
 
 	const std::string &getName();
 	void setName(const std::string& name);
 
-	const std::string &getValue();
-	void setValue(const std::string& value);
+	Value &getValue();
+	void setValue(const Value& value);
 	void setDefaultValue();
 
 	IdentifierT getType() const;
@@ -32,6 +34,9 @@ public:
 	bool getDeclared() const;
 	void setDeclared(bool declared);
 
+	int getSlot() const;
+	void setSlot(int slot);
+
 	LexemeT toConstantLexemeT() const;
 	const std::string printType() const;
 };
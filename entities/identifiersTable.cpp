@@ -35,7 +35,7 @@ std::ostream &operator<<(std::ostream &stream, const IdentifiersTable &identifie
 		stream << "|";
 		printCenter(stream, ident.getDeclared() ? "yes" : "no", 10);
 		stream << "|";
-		printCenter(stream, ident.getValue(), 43);
+		printCenter(stream, ident.getValue().toString(), 43);
 		stream << "|" << std::endl;
 	}
 
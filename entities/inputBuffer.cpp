@@ -0,0 +1,191 @@
+#include "inputBuffer.h"
+
+using namespace std;
+
+InputBuffer::InputBuffer(size_t capacity) {
+	this->buffer = vector<char>(capacity);
+	this->position = 0;
+	this->length = 0;
+	this->eof = false;
+}
+
+void InputBuffer::setReader(const InputReader& reader) {
+	this->reader = reader;
+	this->position = 0;
+	this->length = 0;
+	this->eof = false;
+}
+
+// read() returns available bytes immediately, so interactive input isn't blocked until block is full
+bool InputBuffer::fill() {
+	if (eof)
+		return false;
+
+	ssize_t count;
+
+	if (reader)
+		count = reader(buffer.data(), buffer.size());
+	else {
+		do {
+			count = read(STDIN_FILENO, buffer.data(), buffer.size());
+		} while (count < 0 && errno == EINTR);
+	}
+
+	if (count <= 0) {
+		eof = true;
+		return false;
+	}
+
+	position = 0;
+	length = count;
+
+	return true;
+}
+
+int InputBuffer::get() {
+	if (position == length && !fill())
+		return -1;
+
+	return (unsigned char) buffer[position++];
+}
+
+int InputBuffer::peek() {
+	if (position == length && !fill())
+		return -1;
+
+	return (unsigned char) buffer[position];
+}
+
+bool InputBuffer::readWord(string& word) {
+	int c = get();
+
+	word.clear();
+
+	while (c == ' ' || c == '\n' || c == '\t' || c == '\r')
+		c = get();
+
+	if (c < 0)
+		return false;
+
+	while (c >= 0 && c != ' ' && c != '\n' && c != '\t' && c != '\r') {
+		word += (char) c;
+		c = get();
+	}
+
+	// '\r' of "\r\n" line ending is a part of separator
+	if (c == '\r' && peek() == '\n')
+		get();
+
+	return true;
+}
+
+bool InputBuffer::readLine(string& line) {
+	int c = get();
+
+	line.clear();
+
+	if (c < 0)
+		return false;
+
+	while (c >= 0 && c != '\n') {
+		line += (char) c;
+		c = get();
+	}
+
+	return true;
+}
+
+Integer InputBuffer::readInt() {
+	string word;
+
+	if (!readWord(word))
+		throw string("Unexpected end of input, int value expected");
+
+	size_t start = (word[0] == '-' || word[0] == '+') ? 1 : 0;
+
+	if (start == word.length() || word.find_first_not_of("0123456789", start) != string::npos)
+		throw "Incorrect int value '" + word + "' in input";
+
+	if (word[0] == '+')
+		word.erase(0, 1);
+
+	return Integer(word);
+}
+
+// [sign] digits [. digits] [e [sign] digits] to plain decimal text
+string InputBuffer::realToDecimal(const string& word) const {
+	size_t index = 0;
+	string sign;
+
+	if (word[index] == '-' || word[index] == '+') {
+		if (word[index] == '-')
+			sign = "-";
+
+		index++;
+	}
+
+	string digits;
+	long point = 0;
+
+	while (index < word.length() && isdigit(word[index])) {
+		digits += word[index++];
+		point++;
+	}
+
+	if (index < word.length() && word[index] == '.') {
+		index++;
+
+		while (index < word.length() && isdigit(word[index]))
+			digits += word[index++];
+	}
+
+	if (digits.empty())
+		return "";
+
+	if (index < word.length() && (word[index] == 'e' || word[index] == 'E')) {
+		index++;
+
+		bool negative = index < word.length() && word[index] == '-';
+
+		if (index < word.length() && (word[index] == '-' || word[index] == '+'))
+			index++;
+
+		if (index == word.length())
+			return "";
+
+		long exponent = 0;
+
+		while (index < word.length() && isdigit(word[index]) && exponent <= INPUT_MAX_REAL_EXPONENT)
+			exponent = exponent * 10 + (word[index++] - '0');
+
+		if (exponent > INPUT_MAX_REAL_EXPONENT)
+			throw "Exponent of real value '" + word + "' in input is out of range";
+
+		point += negative ? -exponent : exponent;
+	}
+
+	if (index != word.length())
+		return "";
+
+	if (point <= 0)
+		return sign + "0." + string(-point, '0') + digits;
+
+	if ((size_t) point >= digits.length())
+		return sign + digits + string(point - digits.length(), '0');
+
+	return sign + digits.substr(0, point) + "." + digits.substr(point);
+}
+
+LongDouble InputBuffer::readReal() {
+	string word;
+
+	if (!readWord(word))
+		throw string("Unexpected end of input, real value expected");
+
+	string decimal = realToDecimal(word);
+
+	if (decimal.empty())
+		throw "Incorrect real value '" + word + "' in input";
+
+	return LongDouble(decimal);
+}
@@ -0,0 +1,43 @@
+#ifndef INPUT_BUFFER_H
+#define INPUT_BUFFER_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cerrno>
+#include <unistd.h>
+
+#include "../ariphmetics/Integer.h"
+#include "../ariphmetics/LongDouble.h"
+
+#define INPUT_MAX_REAL_EXPONENT 10000 // maximum absolute exponent of read real value, it is expanded into zero digits
+
+typedef std::function<size_t(char* buffer, size_t size)> InputReader; // returns 0 at the end of input
+
+// reader of stdin by large blocks, numbers are parsed from decimal text without native types
+class InputBuffer {
+	std::vector<char> buffer;
+	size_t position; // index of next unread byte
+	size_t length; // number of bytes in buffer
+	bool eof;
+	InputReader reader; // source of input (stdin if it isn't set)
+
+	bool fill();
+	int get(); // next byte or -1 at the end of input
+	int peek();
+
+	std::string realToDecimal(const std::string& word) const;
+
+public:
+	InputBuffer(size_t capacity = 65536);
+
+	void setReader(const InputReader& reader);
+
+	bool readWord(std::string& word); // word separated by whitespaces, one separator after it is consumed
+	bool readLine(std::string& line);
+
+	Integer readInt();
+	LongDouble readReal();
+};
+
+#endif
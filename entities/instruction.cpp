@@ -0,0 +1,291 @@
+#include "instruction.h"
+
+using namespace std;
+
+Instruction::Instruction(OpCode opcode, int arg) {
+	this->opcode = opcode;
+	this->arg = arg;
+	this->operation = OpCode::nop;
+	this->slot = -1;
+	this->constant = -1;
+	this->line = 0;
+}
+
+Instruction::Instruction(OpCode opcode, OpCode operation, int slot, int constant, int arg) {
+	this->opcode = opcode;
+	this->arg = arg;
+	this->operation = operation;
+	this->slot = slot;
+	this->constant = constant;
+	this->line = 0;
+}
+
+bool Instruction::hasSlot() const {
+	switch (opcode) {
+		case OpCode::load:
+		case OpCode::increment:
+		case OpCode::decrement:
+		case OpCode::add_value_int:
+		case OpCode::sub_value_int:
+		case OpCode::mult_value_int:
+		case OpCode::div_value_int:
+		case OpCode::add_value_real:
+		case OpCode::sub_value_real:
+		case OpCode::mult_value_real:
+		case OpCode::div_value_real:
+		case OpCode::concat_value:
+		case OpCode::assign:
+		case OpCode::read:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+bool Instruction::isJump() const {
+	return opcode == OpCode::go || opcode == OpCode::fgo || 
+		opcode == OpCode::slot_const_int_fgo || opcode == OpCode::const_int_fgo || opcode == OpCode::inc_go;
+}
+
+bool Instruction::isFused() const {
+	return opcode >= OpCode::slot_const_int && opcode <= OpCode::inc_go;
+}
+
+int Instruction::stackEffect() const {
+	switch (opcode) {
+		case OpCode::push:
+		case OpCode::load:
+		case OpCode::slot_const_int:
+			return 1;
+
+		case OpCode::add_value_int:
+		case OpCode::sub_value_int:
+		case OpCode::mult_value_int:
+		case OpCode::div_value_int:
+		case OpCode::add_value_real:
+		case OpCode::sub_value_real:
+		case OpCode::mult_value_real:
+		case OpCode::div_value_real:
+		case OpCode::concat_value:
+		case OpCode::add_int:
+		case OpCode::sub_int:
+		case OpCode::mult_int:
+		case OpCode::div_int:
+		case OpCode::mod_int:
+		case OpCode::add_real:
+		case OpCode::sub_real:
+		case OpCode::mult_real:
+		case OpCode::div_real:
+		case OpCode::concat:
+		case OpCode::equal_int:
+		case OpCode::nequal_int:
+		case OpCode::less_int:
+		case OpCode::greater_int:
+		case OpCode::less_equal_int:
+		case OpCode::greater_equal_int:
+		case OpCode::equal_real:
+		case OpCode::nequal_real:
+		case OpCode::less_real:
+		case OpCode::greater_real:
+		case OpCode::less_equal_real:
+		case OpCode::greater_equal_real:
+		case OpCode::equal_string:
+		case OpCode::nequal_string:
+		case OpCode::less_string:
+		case OpCode::greater_string:
+		case OpCode::assign:
+		case OpCode::write:
+		case OpCode::fgo:
+		case OpCode::const_int_fgo:
+			return -1;
+
+		default:
+			return 0;
+	}
+}
+
+int Instruction::writtenSlot() const {
+	if (opcode == OpCode::inc_go)
+		return slot;
+
+	return hasSlot() && opcode != OpCode::load ? arg : -1;
+}
+
+string Instruction::getName() const {
+	switch (opcode) {
+		case OpCode::nop:
+			return "nop";
+
+		case OpCode::push:
+			return "push";
+
+		case OpCode::load:
+			return "load";
+
+		case OpCode::minus_int:
+			return "minus_int";
+
+		case OpCode::minus_real:
+			return "minus_real";
+
+		case OpCode::increment:
+			return "inc";
+
+		case OpCode::decrement:
+			return "dec";
+
+		case OpCode::add_value_int:
+			return "add_value_int";
+
+		case OpCode::sub_value_int:
+			return "sub_value_int";
+
+		case OpCode::mult_value_int:
+			return "mult_value_int";
+
+		case OpCode::div_value_int:
+			return "div_value_int";
+
+		case OpCode::add_value_real:
+			return "add_value_real";
+
+		case OpCode::sub_value_real:
+			return "sub_value_real";
+
+		case OpCode::mult_value_real:
+			return "mult_value_real";
+
+		case OpCode::div_value_real:
+			return "div_value_real";
+
+		case OpCode::concat_value:
+			return "concat_value";
+
+		case OpCode::logic_not:
+			return "not";
+
+		case OpCode::add_int:
+			return "add_int";
+
+		case OpCode::sub_int:
+			return "sub_int";
+
+		case OpCode::mult_int:
+			return "mult_int";
+
+		case OpCode::div_int:
+			return "div_int";
+
+		case OpCode::mod_int:
+			return "mod_int";
+
+		case OpCode::add_real:
+			return "add_real";
+
+		case OpCode::sub_real:
+			return "sub_real";
+
+		case OpCode::mult_real:
+			return "mult_real";
+
+		case OpCode::div_real:
+			return "div_real";
+
+		case OpCode::concat:
+			return "concat";
+
+		case OpCode::equal_int:
+			return "eq_int";
+
+		case OpCode::nequal_int:
+			return "neq_int";
+
+		case OpCode::less_int:
+			return "lt_int";
+
+		case OpCode::greater_int:
+			return "gt_int";
+
+		case OpCode::less_equal_int:
+			return "le_int";
+
+		case OpCode::greater_equal_int:
+			return "ge_int";
+
+		case OpCode::equal_real:
+			return "eq_real";
+
+		case OpCode::nequal_real:
+			return "neq_real";
+
+		case OpCode::less_real:
+			return "lt_real";
+
+		case OpCode::greater_real:
+			return "gt_real";
+
+		case OpCode::less_equal_real:
+			return "le_real";
+
+		case OpCode::greater_equal_real:
+			return "ge_real";
+
+		case OpCode::equal_string:
+			return "eq_string";
+
+		case OpCode::nequal_string:
+			return "neq_string";
+
+		case OpCode::less_string:
+			return "lt_string";
+
+		case OpCode::greater_string:
+			return "gt_string";
+
+		case OpCode::int_to_real:
+			return "int_to_real";
+
+		case OpCode::real_to_int:
+			return "real_to_int";
+
+		case OpCode::int_to_string:
+			return "int_to_string";
+
+		case OpCode::real_to_string:
+			return "real_to_string";
+
+		case OpCode::assign:
+			return "assign";
+
+		case OpCode::read:
+			return "read";
+
+		case OpCode::write:
+			return "write";
+
+		case OpCode::go:
+			return "go";
+
+		case OpCode::fgo:
+			return "fgo";
+
+		case OpCode::slot_const_int:
+			return "slot_const_int";
+
+		case OpCode::slot_const_int_fgo:
+			return "slot_const_int_fgo";
+
+		case OpCode::const_int_fgo:
+			return "const_int_fgo";
+
+		case OpCode::inc_go:
+			return "inc_go";
+
+		case OpCode::halt:
+			return "halt";
+
+		default:
+			return "unknown";
+	}
+}
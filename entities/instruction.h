@@ -0,0 +1,32 @@
+#ifndef INSTRUCTION_H
+#define INSTRUCTION_H
+
+#include <string>
+
+#include "../enums.h"
+
+class Instruction {
+public:
+	OpCode opcode;
+	int arg; // index of constant (push), slot of variable (load, assign, ...) or jump target (go, fgo)
+
+	// operands of superinstructions
+	OpCode operation; // fused operation
+	int slot; // slot of variable
+	int constant; // index of constant
+
+	unsigned long line; // line of source code
+
+	Instruction(OpCode opcode = OpCode::nop, int arg = 0);
+	Instruction(OpCode opcode, OpCode operation, int slot, int constant, int arg = 0);
+
+	bool hasSlot() const;
+	bool isJump() const;
+	bool isFused() const;
+	int stackEffect() const; // change of operand stack depth after execution
+	int writtenSlot() const; // slot of variable changed by instruction (-1 if variables aren't changed)
+
+	std::string getName() const;
+};
+
+#endif
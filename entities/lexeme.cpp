@@ -6,23 +6,7 @@ Lexeme::Lexeme(LexemeT type, string value, unsigned long lineNumber) {
 	this->type = type;
 	this->lineNumber = lineNumber;
 	this->value = value;
-}
-
-Lexeme::Lexeme(Identifier* ident) {
-	this->value = ident->getValue();
-
-	IdentifierT identT = ident->getType();
-
-	if (identT == IdentifierT::identifier_int)
-		this->type = LexemeT::constant_int;
-	else if (identT == IdentifierT::identifier_real)
-		this->type = LexemeT::constant_real;	
-	else if (identT == IdentifierT::identifier_boolean)
-		this->type = LexemeT::constant_boolean;	
-	else if (identT == IdentifierT::identifier_string)
-		this->type = LexemeT::constant_string;
-	else
-		throw string("Can't convert identifier to constant lexeme");
+	this->valueType = IdentifierT::identifier_unknown;
 }
 
 void Lexeme::setType(LexemeT type) {
@@ -42,6 +26,10 @@ string& Lexeme::getValue() {
 	return value;
 }
 
+const string& Lexeme::getValue() const {
+	return value;
+}
+
 void Lexeme::setLineNumber(unsigned long lineNumber) {
 	this->lineNumber = lineNumber;
 }
@@ -50,6 +38,14 @@ unsigned long Lexeme::getLineNumber() const {
 	return lineNumber;
 }
 
+void Lexeme::setValueType(IdentifierT valueType) {
+	this->valueType = valueType;
+}
+
+IdentifierT Lexeme::getValueType() const {
+	return valueType;
+}
+
 bool Lexeme::check(LexemeT type, const string &value) const {
 	return this->type == type && this->value == value;
 }
@@ -148,6 +144,14 @@ string Lexeme::printForRPN(bool colorful) const {
 			color = BLUE;
 			break;
 
+		case LexemeT::rpn_cast:
+			lexT = "(";
+			lexT += value;
+			lexT += ")";
+
+			color = BLUE;
+			break;
+
 		case LexemeT::rpn_go:
 			lexT = "go";
 			color = BLUE;
@@ -311,6 +315,11 @@ ostream &operator<<(ostream &stream, const Lexeme &lexeme) {
 			color = YELLOW;
 			break;
 
+		case LexemeT::rpn_cast:
+			lexT = "CAST";
+			color = YELLOW;
+			break;
+
 		case LexemeT::rpn_increment:
 			lexT = "INCREMENT";
 			color = YELLOW;
@@ -13,20 +13,24 @@ class Lexeme {
 	LexemeT type;
 	std::string value;
 	unsigned long lineNumber;
+	IdentifierT valueType; // type of operands for operations of reverse polish notation
 
 public:
 	Lexeme(LexemeT type = LexemeT::unknown, std::string value = "", unsigned long lineNumber = 0);
-	Lexeme(class Identifier* ident);
 
 	void setType(LexemeT type = LexemeT::unknown);
 	LexemeT getType() const;
 
 	void setValue(const std::string& value);
 	std::string& getValue();
+	const std::string& getValue() const;
 
 	void setLineNumber(unsigned long lineNumber);
 	unsigned long getLineNumber() const;
 
+	void setValueType(IdentifierT valueType);
+	IdentifierT getValueType() const;
+
 	bool check(LexemeT type, const std::string& value) const;
 
 	bool isConstant() const;
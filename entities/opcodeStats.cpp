@@ -0,0 +1,91 @@
+#include "opcodeStats.h"
+
+using namespace std;
+using namespace std::chrono;
+
+OpcodeStats::OpcodeStats() {
+	size_t size = (size_t) OpCode::halt + 1;
+
+	this->counts = vector<unsigned long long>(size, 0);
+	this->times = vector<unsigned long long>(size, 0);
+	this->histograms = vector<vector<unsigned long long>>(size, vector<unsigned long long>(OPCODE_STATS_BUCKETS, 0));
+	this->operationCounts = vector<vector<unsigned long long>>(size, vector<unsigned long long>(size, 0));
+	this->operationTimes = vector<vector<unsigned long long>>(size, vector<unsigned long long>(size, 0));
+	this->runTime = 0;
+}
+
+void OpcodeStats::add(const Instruction& instruction, steady_clock::duration duration) {
+	unsigned long long ns = duration_cast<nanoseconds>(duration).count();
+	size_t opcode = (size_t) instruction.opcode;
+	size_t bucket = 0;
+
+	while (bucket < OPCODE_STATS_BUCKETS - 1 && (ns >> bucket))
+		bucket++;
+
+	counts[opcode]++;
+	times[opcode] += ns;
+	histograms[opcode][bucket]++;
+
+	if (instruction.isFused()) {
+		operationCounts[opcode][(size_t) instruction.operation]++;
+		operationTimes[opcode][(size_t) instruction.operation] += ns;
+	}
+}
+
+void OpcodeStats::setRunTime(steady_clock::duration duration) {
+	runTime = duration_cast<nanoseconds>(duration).count();
+}
+
+// time of run which isn't spent in instructions is taken by dispatch and measurement itself
+void OpcodeStats::printJSON(FILE* stream) const {
+	unsigned long long instructions = 0, instructionsTime = 0;
+
+	for (size_t i = 0; i < counts.size(); i++) {
+		instructions += counts[i];
+		instructionsTime += times[i];
+	}
+
+	fprintf(stream, "{\n");
+	fprintf(stream, "  \"run_ns\": %llu,\n", runTime);
+	fprintf(stream, "  \"instructions\": %llu,\n", instructions);
+	fprintf(stream, "  \"instructions_ns\": %llu,\n", instructionsTime);
+	fprintf(stream, "  \"dispatch_ns\": %llu,\n", runTime > instructionsTime ? runTime - instructionsTime : 0);
+	fprintf(stream, "  \"opcodes\": [");
+
+	bool first = true;
+
+	for (size_t i = 0; i < counts.size(); i++) {
+		if (!counts[i])
+			continue;
+
+		fprintf(stream, "%s\n    {\"name\": \"%s\", \"count\": %llu, \"total_ns\": %llu, \"histogram_ns\": {", first ? "" : ",", Instruction((OpCode) i).getName().c_str(), counts[i], times[i]);
+
+		bool firstBucket = true;
+
+		for (size_t j = 0; j < OPCODE_STATS_BUCKETS; j++) {
+			if (!histograms[i][j])
+				continue;
+
+			fprintf(stream, "%s\"<%llu\": %llu", firstBucket ? "" : ", ", 1ULL << j, histograms[i][j]);
+			firstBucket = false;
+		}
+
+		fprintf(stream, "}");
+
+		// inc_go has only one operation (nop), so it isn't split
+		bool firstOperation = true;
+
+		for (size_t j = 1; j < operationCounts[i].size(); j++) {
+			if (!operationCounts[i][j])
+				continue;
+
+			fprintf(stream, "%s{\"name\": \"%s\", \"count\": %llu, \"total_ns\": %llu}", firstOperation ? ", \"operations\": [" : ", ", Instruction((OpCode) j).getName().c_str(), operationCounts[i][j], operationTimes[i][j]);
+			firstOperation = false;
+		}
+
+		fprintf(stream, "%s}", firstOperation ? "" : "]");
+		first = false;
+	}
+
+	fprintf(stream, "\n  ]\n}\n");
+}
@@ -0,0 +1,34 @@
+#ifndef OPCODE_STATS_H
+#define OPCODE_STATS_H
+
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../enums.h"
+#include "instruction.h"
+
+#define OPCODE_STATS_BUCKETS 40
+
+// execution count, total time and histogram of time (bucket i for less than 2^i ns) of every opcode
+// collected by executor built with -DOPCODE_STATS
+// superinstructions are also counted by fused operation (slot_const_int with add_int, less_int, ...)
+class OpcodeStats {
+	std::vector<unsigned long long> counts;
+	std::vector<unsigned long long> times; // total time in ns
+	std::vector<std::vector<unsigned long long>> histograms;
+	std::vector<std::vector<unsigned long long>> operationCounts; // by opcode and fused operation
+	std::vector<std::vector<unsigned long long>> operationTimes;
+	unsigned long long runTime; // time of whole execution in ns
+
+public:
+	OpcodeStats();
+
+	void add(const Instruction& instruction, std::chrono::steady_clock::duration duration);
+	void setRunTime(std::chrono::steady_clock::duration duration);
+
+	void printJSON(FILE* stream) const;
+};
+
+#endif
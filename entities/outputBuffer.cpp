@@ -0,0 +1,63 @@
+#include "outputBuffer.h"
+
+using namespace std;
+
+OutputBuffer::OutputBuffer(size_t capacity, bool lineBuffered) {
+	this->buffer = vector<char>(capacity);
+	this->length = 0;
+	this->lineBuffered = lineBuffered;
+}
+
+OutputBuffer::~OutputBuffer() {
+	flush();
+}
+
+void OutputBuffer::setCapacity(size_t capacity) {
+	flush();
+	buffer.resize(capacity);
+}
+
+void OutputBuffer::setLineBuffered(bool lineBuffered) {
+	this->lineBuffered = lineBuffered;
+}
+
+void OutputBuffer::setWriter(const OutputWriter& writer) {
+	flush();
+	this->writer = writer;
+}
+
+void OutputBuffer::writeData(const char* data, size_t size) {
+	if (writer) {
+		if (size)
+			writer(data, size);
+
+		return;
+	}
+
+	fwrite(data, 1, size, stdout);
+	fflush(stdout);
+}
+
+void OutputBuffer::write(const string& s) {
+	if (length + s.length() > buffer.size()) {
+		flush();
+
+		// too long strings are written directly
+		if (s.length() > buffer.size()) {
+			writeData(s.data(), s.length());
+
+			return;
+		}
+	}
+
+	s.copy(buffer.data() + length, s.length());
+	length += s.length();
+
+	if (lineBuffered && s.find('\n') != string::npos)
+		flush();
+}
+
+void OutputBuffer::flush() {
+	writeData(buffer.data(), length);
+	length = 0;
+}
@@ -0,0 +1,35 @@
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+typedef std::function<void(const char* data, size_t size)> OutputWriter;
+
+// buffer of program output, written to stdout when it's full, at the end of line (line mode) or on flush
+class OutputBuffer {
+	std::vector<char> buffer;
+	size_t length; // number of used bytes
+	bool lineBuffered;
+	OutputWriter writer; // destination of output (stdout if it isn't set)
+
+	void writeData(const char* data, size_t size);
+
+public:
+	OutputBuffer(size_t capacity = 65536, bool lineBuffered = false);
+	~OutputBuffer();
+
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+	void setCapacity(size_t capacity); // 0 for unbuffered output
+	void setLineBuffered(bool lineBuffered);
+	void setWriter(const OutputWriter& writer);
+
+	void write(const std::string& s);
+	void flush();
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "profiler.h"
+
+using namespace std;
+using namespace std::chrono;
+
+Profiler::Profiler(size_t linesCount) {
+	this->hits = vector<unsigned long long>(linesCount + 1, 0);
+	this->times = vector<steady_clock::duration>(linesCount + 1, steady_clock::duration::zero());
+	this->line = 0;
+}
+
+void Profiler::start() {
+	lineStart = steady_clock::now();
+}
+
+void Profiler::stop() {
+	changeLine(line);
+}
+
+void Profiler::changeLine(unsigned long line) {
+	steady_clock::time_point now = steady_clock::now();
+
+	times[this->line] += now - lineStart;
+	lineStart = now;
+
+	if (line >= hits.size()) {
+		hits.resize(line + 1, 0);
+		times.resize(line + 1, steady_clock::duration::zero());
+	}
+
+	this->line = line;
+}
+
+void Profiler::print(const vector<string>& lines) const {
+	unsigned long long totalHits = 0;
+	steady_clock::duration totalTime = steady_clock::duration::zero();
+
+	for (size_t i = 0; i < hits.size(); i++) {
+		totalHits += hits[i];
+		totalTime += times[i];
+	}
+
+	double total = duration<double, milli>(totalTime).count();
+
+	printf("\n%sProfile (%llu instructions executed, %.3f ms):%s\n", BOLDMAGENTA, totalHits, total, RESET);
+	printf("%s%6s %14s %12s %7s  %s%s\n", BOLDBLUE, "line", "instructions", "time, ms", "time, %", "source", RESET);
+
+	for (size_t i = 0; i < lines.size(); i++) {
+		unsigned long long count = i < hits.size() ? hits[i] : 0;
+
+		if (!count) {
+			printf("%6zu %14s %12s %7s  %s\n", i + 1, "", "", "", lines[i].c_str());
+			continue;
+		}
+
+		double time = duration<double, milli>(times[i]).count();
+		double percent = total > 0 ? time * 100 / total : 0;
+
+		bool hot = percent >= 10;
+
+		printf("%s%6zu %14llu %12.3f %7.2f  %s%s\n", hot ? BOLDRED : "", i + 1, count, time, percent, lines[i].c_str(), hot ? RESET : "");
+	}
+}
@@ -0,0 +1,36 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../colors.h"
+
+// executed instructions and time by line of source code, clock is read only when line changes
+class Profiler {
+	std::vector<unsigned long long> hits; // executed instructions by line
+	std::vector<std::chrono::steady_clock::duration> times; // time by line
+	unsigned long line; // line of current instruction
+	std::chrono::steady_clock::time_point lineStart;
+
+	void changeLine(unsigned long line);
+
+public:
+	Profiler(size_t linesCount);
+
+	void start();
+	void stop();
+
+	void step(unsigned long line) {
+		if (line != this->line)
+			changeLine(line);
+
+		hits[line]++;
+	}
+
+	void print(const std::vector<std::string>& lines) const;
+};
+
+#endif
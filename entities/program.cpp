@@ -0,0 +1,112 @@
+#include "program.h"
+#include "programImage.h"
+
+using namespace std;
+
+Program::Program() {
+	stackSize = 0;
+}
+
+size_t Program::size() const {
+	return image ? image->size() : instructions.size();
+}
+
+const Instruction* Program::getCode() const {
+	return image ? image->getCode() : instructions.data();
+}
+
+void Program::setImage(shared_ptr<const ProgramImage> image) {
+	this->image = image;
+	this->instructions.clear();
+}
+
+size_t Program::computeStackSize(const Instruction* code, size_t size) {
+	vector<int> depths(size, -1);
+	vector<size_t> indexes(1, 0);
+	int maxDepth = 0;
+
+	depths[0] = 0;
+
+	while (!indexes.empty()) {
+		size_t index = indexes.back();
+		indexes.pop_back();
+
+		const Instruction& instruction = code[index];
+		int depth = depths[index] + instruction.stackEffect();
+
+		if (depth < 0)
+			throw string("Operand stack underflow in program");
+
+		maxDepth = max(maxDepth, depth);
+
+		vector<size_t> next;
+
+		if (instruction.isJump())
+			next.push_back(instruction.arg);
+
+		if (instruction.opcode != OpCode::go && instruction.opcode != OpCode::inc_go && instruction.opcode != OpCode::halt)
+			next.push_back(index + 1);
+
+		for (size_t i = 0; i < next.size(); i++) {
+			if (depths[next[i]] == -1) {
+				depths[next[i]] = depth;
+				indexes.push_back(next[i]);
+			}
+			else if (depths[next[i]] != depth)
+				throw string("Inconsistent operand stack depth in program");
+		}
+	}
+
+	return maxDepth;
+}
+
+int Program::addConstant(const Value& value) {
+	constants.push_back(value);
+
+	return constants.size() - 1;
+}
+
+string Program::printInstruction(size_t index, bool colorful) const {
+	const Instruction& instruction = getCode()[index];
+	string out = instruction.getName();
+
+	if (instruction.opcode == OpCode::push) {
+		const Value& value = constants[instruction.arg];
+
+		out += " ";
+		out += Lexeme(value.toConstantLexemeT(), value.toString()).printForRPN(colorful);
+	}
+	else if (instruction.isFused()) {
+		if (instruction.operation != OpCode::nop)
+			out += " " + Instruction(instruction.operation).getName();
+
+		if (instruction.slot >= 0)
+			out += " " + Lexeme(LexemeT::identifier, names[instruction.slot]).printForRPN(colorful);
+
+		if (instruction.constant >= 0) {
+			const Value& value = constants[instruction.constant];
+
+			out += " " + Lexeme(value.toConstantLexemeT(), value.toString()).printForRPN(colorful);
+		}
+
+		if (instruction.isJump())
+			out += " " + Lexeme(LexemeT::rpn_label, to_string(instruction.arg)).printForRPN(colorful);
+	}
+	else if (instruction.isJump()) {
+		out += " ";
+		out += Lexeme(LexemeT::rpn_label, to_string(instruction.arg)).printForRPN(colorful);
+	}
+	else if (instruction.hasSlot()) {
+		out += " ";
+		out += Lexeme(LexemeT::identifier, names[instruction.arg]).printForRPN(colorful);
+	}
+
+	return out;
+}
+
+ostream &operator<<(ostream &stream, const Program &program) {
+	for (size_t i = 0; i < program.size(); i++)
+		stream << i << ": " << program.printInstruction(i) << endl;
+
+	return stream;
+}
@@ -0,0 +1,41 @@
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "instruction.h"
+#include "lexeme.h"
+#include "value.h"
+
+class ProgramImage;
+
+class Program {
+	std::shared_ptr<const ProgramImage> image; // mapped image with instructions (nullptr for compiled program)
+
+public:
+	std::vector<Instruction> instructions; // instructions of compiled program (empty if image is used)
+	std::vector<Value> constants; // values of push instructions
+	std::vector<std::string> names; // names of variables by slot
+	std::vector<Value> variables; // initial values of variables by slot
+	size_t stackSize; // maximum depth of operand stack
+
+	Program();
+
+	size_t size() const;
+	const Instruction* getCode() const; // instructions of image or of compiled program
+
+	void setImage(std::shared_ptr<const ProgramImage> image);
+
+	static size_t computeStackSize(const Instruction* code, size_t size); // throws for underflow or inconsistent depth at jump targets
+
+	int addConstant(const Value& value);
+
+	std::string printInstruction(size_t index, bool colorful = true) const;
+
+	friend std::ostream &operator<<(std::ostream &stream, const Program &program);
+};
+
+#endif
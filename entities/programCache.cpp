@@ -0,0 +1,63 @@
+#include "programCache.h"
+
+using namespace std;
+
+ProgramCache::ProgramCache(const string& directory) {
+	this->directory = directory;
+}
+
+uint64_t ProgramCache::makeKey(const string& source, bool optimize) const {
+	string version = to_string(PROGRAM_IMAGE_VERSION) + " " + to_string((int) OpCode::halt) + " " + to_string(sizeof(Instruction)) + (optimize ? " O" : " O0");
+	uint64_t h = ProgramImage::hash(version.c_str(), version.length());
+
+	return ProgramImage::hash(source.c_str(), source.length(), h);
+}
+
+string ProgramCache::getPath(uint64_t key) const {
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.mlc", (unsigned long long) key);
+
+	return directory + "/" + name;
+}
+
+// instructions stay in mapped file and are used by executor in place
+bool ProgramCache::load(uint64_t key, Program& program) const {
+	shared_ptr<ProgramImage> image = make_shared<ProgramImage>();
+
+	if (!image->map(getPath(key)))
+		return false;
+
+	try {
+		Program mapped;
+
+		image->check(key);
+		image->readData(mapped);
+		mapped.setImage(image);
+
+		program = mapped;
+	}
+	catch (string e) {
+		return false;
+	}
+
+	return true;
+}
+
+// entry is written to temporary file and renamed, so other processes never map half-written entry
+void ProgramCache::save(uint64_t key, const Program& program) const {
+	string image = ProgramImage::build(program, key);
+
+	mkdir(directory.c_str(), 0755);
+
+	string path = getPath(key);
+	string tmpPath = path + ".tmp" + to_string(getpid());
+	FILE* file = fopen(tmpPath.c_str(), "wb");
+
+	if (!file)
+		return;
+
+	bool written = fwrite(image.data(), 1, image.size(), file) == image.size();
+
+	if (fclose(file) || !written || rename(tmpPath.c_str(), path.c_str()))
+		remove(tmpPath.c_str());
+}
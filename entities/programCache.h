@@ -0,0 +1,32 @@
+#ifndef PROGRAM_CACHE_H
+#define PROGRAM_CACHE_H
+
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "../enums.h"
+#include "instruction.h"
+#include "program.h"
+#include "programImage.h"
+
+// images of compiled programs stored in directory by hash of source, so unchanged sources are not analyzed again
+class ProgramCache {
+	std::string directory;
+
+	std::string getPath(uint64_t key) const;
+
+public:
+	ProgramCache(const std::string& directory);
+
+	uint64_t makeKey(const std::string& source, bool optimize) const;
+
+	bool load(uint64_t key, Program& program) const; // false for missing, stale or corrupted entry
+	void save(uint64_t key, const Program& program) const; // errors of writing are ignored
+};
+
+#endif
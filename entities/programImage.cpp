@@ -0,0 +1,214 @@
+#include "programImage.h"
+
+using namespace std;
+
+static_assert(is_trivially_copyable<Instruction>::value && is_standard_layout<Instruction>::value, "instructions must be used in place");
+
+ProgramImage::ProgramImage() {
+	this->data = nullptr;
+	this->length = 0;
+}
+
+ProgramImage::~ProgramImage() {
+	if (data)
+		munmap((void*) data, length);
+}
+
+uint64_t ProgramImage::hash(const char* data, size_t size, uint64_t seed) {
+	uint64_t h = seed;
+
+	for (size_t i = 0; i < size; i++) {
+		h ^= (unsigned char) data[i];
+		h *= 1099511628211ULL;
+	}
+
+	return h;
+}
+
+// header, instructions, constants, variables, texts
+string ProgramImage::build(const Program& program, uint64_t key) {
+	ProgramImageHeader header;
+	memset(&header, 0, sizeof(header));
+
+	string texts;
+	vector<ProgramImageValue> constants;
+	vector<ProgramImageVariable> variables;
+
+	auto addText = [&texts](uint64_t type, const string& text) {
+		ProgramImageValue value;
+		value.type = type;
+		value.offset = texts.length();
+		value.length = text.length();
+		texts += text;
+
+		return value;
+	};
+
+	for (size_t i = 0; i < program.constants.size(); i++)
+		constants.push_back(addText((uint64_t) program.constants[i].getType(), program.constants[i].toString()));
+
+	for (size_t i = 0; i < program.variables.size(); i++) {
+		ProgramImageVariable variable;
+		variable.name = addText(0, program.names[i]);
+		variable.value = addText((uint64_t) program.variables[i].getType(), program.variables[i].toString());
+		variables.push_back(variable);
+	}
+
+	header.magic = PROGRAM_IMAGE_MAGIC;
+	header.version = PROGRAM_IMAGE_VERSION;
+	header.key = key;
+	header.stackSize = program.stackSize;
+
+	header.codeOffset = (sizeof(header) + 15) / 16 * 16;
+	header.codeCount = program.size();
+	header.constantsOffset = header.codeOffset + header.codeCount * sizeof(Instruction);
+	header.constantsCount = constants.size();
+	header.variablesOffset = header.constantsOffset + constants.size() * sizeof(ProgramImageValue);
+	header.variablesCount = variables.size();
+	header.textsOffset = header.variablesOffset + variables.size() * sizeof(ProgramImageVariable);
+	header.textsSize = texts.length();
+	header.size = header.textsOffset + header.textsSize;
+
+	string image(header.size, '\0');
+
+	memcpy(&image[header.codeOffset], program.getCode(), header.codeCount * sizeof(Instruction));
+
+	if (!constants.empty())
+		memcpy(&image[header.constantsOffset], constants.data(), constants.size() * sizeof(ProgramImageValue));
+
+	if (!variables.empty())
+		memcpy(&image[header.variablesOffset], variables.data(), variables.size() * sizeof(ProgramImageVariable));
+
+	texts.copy(&image[header.textsOffset], texts.length());
+
+	header.checksum = hash(image.data() + sizeof(header), image.size() - sizeof(header));
+	memcpy(&image[0], &header, sizeof(header));
+
+	return image;
+}
+
+bool ProgramImage::map(const string& path) {
+	int file = open(path.c_str(), O_RDONLY);
+
+	if (file < 0)
+		return false;
+
+	struct stat info;
+
+	if (fstat(file, &info) || info.st_size < (off_t) sizeof(ProgramImageHeader)) {
+		close(file);
+		return false;
+	}
+
+	void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+
+	if (mapped == MAP_FAILED)
+		return false;
+
+	data = (const char*) mapped;
+	length = info.st_size;
+
+	return true;
+}
+
+const ProgramImageHeader& ProgramImage::header() const {
+	return *(const ProgramImageHeader*) data;
+}
+
+// sections must be inside of image and instructions must refer only to existing constants, variables and instructions
+void ProgramImage::check(uint64_t key) const {
+	const ProgramImageHeader& h = header();
+
+	if (h.magic != PROGRAM_IMAGE_MAGIC || h.version != PROGRAM_IMAGE_VERSION || h.key != key)
+		throw string("Stale program image");
+
+	if (h.size != length || h.checksum != hash(data + sizeof(h), length - sizeof(h)))
+		throw string("Corrupted program image");
+
+	if (h.codeOffset % alignof(Instruction) || h.codeOffset < sizeof(h) || h.codeCount > length / sizeof(Instruction) ||
+		h.constantsOffset != h.codeOffset + h.codeCount * sizeof(Instruction) || h.constantsCount > length / sizeof(ProgramImageValue) ||
+		h.variablesOffset != h.constantsOffset + h.constantsCount * sizeof(ProgramImageValue) || h.variablesCount > length / sizeof(ProgramImageVariable) ||
+		h.textsOffset != h.variablesOffset + h.variablesCount * sizeof(ProgramImageVariable) || h.textsOffset + h.textsSize != length)
+		throw string("Incorrect sections of program image");
+
+	const Instruction* code = getCode();
+
+	if (!h.codeCount || code[h.codeCount - 1].opcode != OpCode::halt)
+		throw string("Program image must end with halt");
+
+	for (size_t i = 0; i < h.codeCount; i++) {
+		const Instruction& instruction = code[i];
+
+		if (instruction.opcode < OpCode::nop || instruction.opcode > OpCode::halt || instruction.operation < OpCode::nop || instruction.operation > OpCode::halt)
+			throw string("Incorrect opcode in program image");
+
+		if (instruction.isJump() && (instruction.arg < 0 || (uint64_t) instruction.arg >= h.codeCount))
+			throw string("Incorrect jump in program image");
+
+		if (instruction.opcode == OpCode::push && (instruction.arg < 0 || (uint64_t) instruction.arg >= h.constantsCount))
+			throw string("Incorrect constant in program image");
+
+		if (instruction.hasSlot() && (instruction.arg < 0 || (uint64_t) instruction.arg >= h.variablesCount))
+			throw string("Incorrect slot in program image");
+
+		if (!instruction.isFused())
+			continue;
+
+		// const_int_fgo has no slot and inc_go has no constant, other superinstructions have both
+		if (instruction.opcode != OpCode::const_int_fgo && (instruction.slot < 0 || (uint64_t) instruction.slot >= h.variablesCount))
+			throw string("Incorrect operand in program image");
+
+		if (instruction.opcode != OpCode::inc_go && (instruction.constant < 0 || (uint64_t) instruction.constant >= h.constantsCount))
+			throw string("Incorrect operand in program image");
+	}
+}
+
+const Instruction* ProgramImage::getCode() const {
+	return (const Instruction*) (data + header().codeOffset);
+}
+
+size_t ProgramImage::size() const {
+	return header().codeCount;
+}
+
+string ProgramImage::getText(const ProgramImageValue& value) const {
+	const ProgramImageHeader& h = header();
+
+	if (value.offset > h.textsSize || value.length > h.textsSize - value.offset)
+		throw string("Incorrect text in program image");
+
+	return string(data + h.textsOffset + value.offset, value.length);
+}
+
+Value ProgramImage::getValue(const ProgramImageValue& value) const {
+	string text = getText(value);
+
+	if (value.type == (uint64_t) IdentifierT::identifier_unknown)
+		return Value();
+
+	if (value.type > (uint64_t) IdentifierT::identifier_boolean)
+		throw string("Incorrect type of value in program image");
+
+	return Value((IdentifierT) value.type, text);
+}
+
+void ProgramImage::readData(Program& program) const {
+	const ProgramImageHeader& h = header();
+	const ProgramImageValue* constants = (const ProgramImageValue*) (data + h.constantsOffset);
+	const ProgramImageVariable* variables = (const ProgramImageVariable*) (data + h.variablesOffset);
+
+	// executor preallocates operand stack by this size, so it can't be less than depth of code
+	if (h.stackSize < Program::computeStackSize(getCode(), h.codeCount))
+		throw string("Incorrect stack size in program image");
+
+	program.stackSize = h.stackSize;
+
+	for (size_t i = 0; i < h.constantsCount; i++)
+		program.constants.push_back(getValue(constants[i]));
+
+	for (size_t i = 0; i < h.variablesCount; i++) {
+		program.names.push_back(getText(variables[i].name));
+		program.variables.push_back(getValue(variables[i].value));
+	}
+}
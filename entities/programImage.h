@@ -0,0 +1,81 @@
+#ifndef PROGRAM_IMAGE_H
+#define PROGRAM_IMAGE_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "../enums.h"
+#include "instruction.h"
+#include "program.h"
+#include "value.h"
+
+#define PROGRAM_IMAGE_MAGIC 0x43504c4d // "MLPC"
+#define PROGRAM_IMAGE_VERSION 2 // must be increased with any change of compiler, instructions or this format
+
+// all offsets are counted from the beginning of image, so it can be mapped at any address
+struct ProgramImageHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key; // hash of source, compiler version and options
+	uint64_t size; // size of whole image
+	uint64_t checksum; // hash of image after header
+	uint64_t stackSize;
+
+	uint64_t codeOffset; // array of instructions used in place
+	uint64_t codeCount;
+	uint64_t constantsOffset; // array of ProgramImageValue
+	uint64_t constantsCount;
+	uint64_t variablesOffset; // array of ProgramImageVariable
+	uint64_t variablesCount;
+	uint64_t textsOffset; // texts of values and names
+	uint64_t textsSize;
+};
+
+struct ProgramImageValue {
+	uint64_t type;
+	uint64_t offset; // offset of text in texts of image
+	uint64_t length;
+};
+
+struct ProgramImageVariable {
+	ProgramImageValue name;
+	ProgramImageValue value;
+};
+
+// compiled program mapped read-only from file: instructions are shared by all processes executing it
+// only constants and variables are converted to values, because values own their memory
+class ProgramImage {
+	const char* data;
+	size_t length;
+
+	const ProgramImageHeader& header() const;
+	std::string getText(const ProgramImageValue& value) const;
+	Value getValue(const ProgramImageValue& value) const;
+
+public:
+	ProgramImage();
+	~ProgramImage();
+
+	ProgramImage(const ProgramImage&) = delete;
+	ProgramImage& operator=(const ProgramImage&) = delete;
+
+	static uint64_t hash(const char* data, size_t size, uint64_t seed = 14695981039346656037ULL); // FNV-1a
+	static std::string build(const Program& program, uint64_t key);
+
+	bool map(const std::string& path);
+	void check(uint64_t key) const; // throws for stale or broken image
+
+	const Instruction* getCode() const;
+	size_t size() const;
+
+	void readData(Program& program) const; // constants, names and initial values of variables
+};
+
+#endif
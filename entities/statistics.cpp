@@ -0,0 +1,67 @@
+#include "statistics.h"
+
+using namespace std;
+using namespace std::chrono;
+
+Statistics::Statistics() {
+	start();
+}
+
+void Statistics::start() {
+	wallStart = steady_clock::now();
+	cpuStart = clock();
+}
+
+void Statistics::endPhase(const string& name) {
+	steady_clock::time_point wallEnd = steady_clock::now();
+	clock_t cpuEnd = clock();
+
+	phases.push_back(name);
+	wallTimes.push_back(duration<double, milli>(wallEnd - wallStart).count());
+	cpuTimes.push_back(double(cpuEnd - cpuStart) * 1000 / CLOCKS_PER_SEC);
+
+	wallStart = wallEnd;
+	cpuStart = cpuEnd;
+}
+
+void Statistics::setCounter(const string& name, unsigned long long value) {
+	counters.push_back(make_pair(name, value));
+}
+
+double Statistics::getWallTime(const string& phase) const {
+	for (size_t i = 0; i < phases.size(); i++)
+		if (phases[i] == phase)
+			return wallTimes[i];
+
+	return 0;
+}
+
+long Statistics::peakRSS() const {
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage))
+		return 0;
+
+	return usage.ru_maxrss;
+}
+
+void Statistics::printJSON(FILE* stream) const {
+	double wallTotal = 0, cpuTotal = 0;
+
+	fprintf(stream, "{\n  \"phases\": {");
+
+	for (size_t i = 0; i < phases.size(); i++) {
+		fprintf(stream, "%s\n    \"%s\": {\"wall_ms\": %.3f, \"cpu_ms\": %.3f}", i ? "," : "", phases[i].c_str(), wallTimes[i], cpuTimes[i]);
+
+		wallTotal += wallTimes[i];
+		cpuTotal += cpuTimes[i];
+	}
+
+	fprintf(stream, "\n  },\n");
+	fprintf(stream, "  \"total\": {\"wall_ms\": %.3f, \"cpu_ms\": %.3f},\n", wallTotal, cpuTotal);
+
+	for (size_t i = 0; i < counters.size(); i++)
+		fprintf(stream, "  \"%s\": %llu,\n", counters[i].first.c_str(), counters[i].second);
+
+	fprintf(stream, "  \"peak_rss_kb\": %ld\n}\n", peakRSS());
+}
@@ -0,0 +1,37 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+// wall (steady clock) and cpu time of interpreter phases and counters of processed program
+class Statistics {
+	std::vector<std::string> phases;
+	std::vector<double> wallTimes; // ms
+	std::vector<double> cpuTimes; // ms
+	std::vector<std::pair<std::string, unsigned long long>> counters;
+
+	std::chrono::steady_clock::time_point wallStart; // start of current phase
+	clock_t cpuStart;
+
+	long peakRSS() const; // maximum resident set size in KB
+
+public:
+	Statistics();
+
+	void start();
+	void endPhase(const std::string& name); // next phase starts at the end of previous one
+	void setCounter(const std::string& name, unsigned long long value);
+
+	double getWallTime(const std::string& phase) const; // ms, 0 for unknown phase
+
+	void printJSON(FILE* stream) const;
+};
+
+#endif
@@ -0,0 +1,247 @@
+#include "value.h"
+
+using namespace std;
+
+void Value::init(const Value& value) {
+	type = value.type;
+
+	switch (type) {
+		case IdentifierT::identifier_int:
+			new (&intValue) Integer(value.intValue);
+			break;
+
+		case IdentifierT::identifier_real:
+			new (&realValue) LongDouble(value.realValue);
+			break;
+
+		case IdentifierT::identifier_string:
+			new (&stringValue) string(value.stringValue);
+			break;
+
+		default:
+			boolValue = value.boolValue;
+			break;
+	}
+}
+
+void Value::clear() {
+	switch (type) {
+		case IdentifierT::identifier_int:
+			intValue.~Integer();
+			break;
+
+		case IdentifierT::identifier_real:
+			realValue.~LongDouble();
+			break;
+
+		case IdentifierT::identifier_string:
+			stringValue.~string();
+			break;
+
+		default:
+			break;
+	}
+
+	type = IdentifierT::identifier_unknown;
+}
+
+Value::Value() {
+	type = IdentifierT::identifier_unknown;
+	boolValue = false;
+}
+
+Value::Value(const Integer& value) {
+	type = IdentifierT::identifier_int;
+	new (&intValue) Integer(value);
+}
+
+Value::Value(const LongDouble& value) {
+	type = IdentifierT::identifier_real;
+	new (&realValue) LongDouble(value);
+}
+
+Value::Value(bool value) {
+	type = IdentifierT::identifier_boolean;
+	boolValue = value;
+}
+
+Value::Value(const string& value) {
+	type = IdentifierT::identifier_string;
+	new (&stringValue) string(value);
+}
+
+Value::Value(IdentifierT type, const string& text) {
+	this->type = type;
+
+	switch (type) {
+		case IdentifierT::identifier_int:
+			new (&intValue) Integer(text);
+			break;
+
+		case IdentifierT::identifier_real:
+			new (&realValue) LongDouble(text);
+			break;
+
+		case IdentifierT::identifier_string:
+			new (&stringValue) string(text);
+			break;
+
+		case IdentifierT::identifier_boolean:
+			boolValue = text == LEX_TRUE;
+			break;
+
+		default:
+			throw string("Can't create value of unknown type");
+	}
+}
+
+Value::Value(const Value& value) {
+	init(value);
+}
+
+Value::~Value() {
+	clear();
+}
+
+Value& Value::operator=(const Value& value) {
+	if (this == &value)
+		return *this;
+
+	if (type == value.type) {
+		switch (type) {
+			case IdentifierT::identifier_int:
+				intValue = value.intValue;
+				break;
+
+			case IdentifierT::identifier_real:
+				realValue = value.realValue;
+				break;
+
+			case IdentifierT::identifier_string:
+				stringValue = value.stringValue;
+				break;
+
+			default:
+				boolValue = value.boolValue;
+				break;
+		}
+	}
+	else {
+		clear();
+		init(value);
+	}
+
+	return *this;
+}
+
+IdentifierT Value::getType() const {
+	return type;
+}
+
+bool Value::isNumber() const {
+	return type == IdentifierT::identifier_int || type == IdentifierT::identifier_real;
+}
+
+size_t Value::bignumDigits() const {
+	if (type == IdentifierT::identifier_int)
+		return intValue.digitsCount();
+
+	if (type == IdentifierT::identifier_real)
+		return realValue.digitsCount();
+
+	return 0;
+}
+
+Integer& Value::getInt() {
+	if (type != IdentifierT::identifier_int)
+		throw string("Expected int value");
+
+	return intValue;
+}
+
+const Integer& Value::getInt() const {
+	if (type != IdentifierT::identifier_int)
+		throw string("Expected int value");
+
+	return intValue;
+}
+
+LongDouble& Value::getReal() {
+	if (type != IdentifierT::identifier_real)
+		throw string("Expected real value");
+
+	return realValue;
+}
+
+const LongDouble& Value::getReal() const {
+	if (type != IdentifierT::identifier_real)
+		throw string("Expected real value");
+
+	return realValue;
+}
+
+bool Value::getBool() const {
+	if (type != IdentifierT::identifier_boolean)
+		throw string("Expected boolean value");
+
+	return boolValue;
+}
+
+string& Value::getString() {
+	if (type != IdentifierT::identifier_string)
+		throw string("Expected string value");
+
+	return stringValue;
+}
+
+LongDouble Value::toReal() const {
+	if (type == IdentifierT::identifier_real)
+		return realValue;
+
+	if (type == IdentifierT::identifier_int)
+		return intValue.toLongDouble();
+
+	throw string("Expected real value");
+}
+
+LexemeT Value::toConstantLexemeT() const {
+	switch (type) {
+		case IdentifierT::identifier_int:
+			return LexemeT::constant_int;
+
+		case IdentifierT::identifier_real:
+			return LexemeT::constant_real;
+
+		case IdentifierT::identifier_string:
+			return LexemeT::constant_string;
+
+		case IdentifierT::identifier_boolean:
+			return LexemeT::constant_boolean;
+
+		default:
+			return LexemeT::unknown;
+	}
+}
+
+string Value::toString() const {
+	switch (type) {
+		case IdentifierT::identifier_int:
+			return intValue.toString();
+
+		case IdentifierT::identifier_real:
+			return realValue.toString();
+
+		case IdentifierT::identifier_string:
+			return stringValue;
+
+		case IdentifierT::identifier_boolean:
+			return boolValue ? LEX_TRUE : LEX_FALSE;
+
+		default:
+			return "";
+	}
+}
+
+ostream &operator<<(ostream &stream, const Value &value) {
+	return stream << value.toString();
+}
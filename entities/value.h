@@ -0,0 +1,58 @@
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <new>
+#include <string>
+#include <ostream>
+
+#include "../enums.h"
+#include "../ariphmetics/LongInt.h"
+#include "../ariphmetics/Integer.h"
+#include "../ariphmetics/LongDouble.h"
+
+// runtime value of the interpreted program: holds int, real, boolean or string natively
+class Value {
+	IdentifierT type;
+
+	union {
+		Integer intValue;
+		LongDouble realValue;
+		bool boolValue;
+		std::string stringValue;
+	};
+
+	void init(const Value& value);
+	void clear();
+
+public:
+	Value();
+	Value(const Integer& value);
+	Value(const LongDouble& value);
+	Value(bool value);
+	Value(const std::string& value);
+	Value(IdentifierT type, const std::string& text); // parse constant of given type
+	Value(const Value& value);
+	~Value();
+
+	Value& operator=(const Value& value);
+
+	IdentifierT getType() const;
+	bool isNumber() const;
+	size_t bignumDigits() const; // digits of LongInt or LongDouble (0 for other values)
+
+	Integer& getInt();
+	const Integer& getInt() const;
+	LongDouble& getReal();
+	const LongDouble& getReal() const;
+	bool getBool() const;
+	std::string& getString();
+
+	LongDouble toReal() const; // int values are converted to real
+
+	LexemeT toConstantLexemeT() const;
+	std::string toString() const;
+
+	friend std::ostream &operator<<(std::ostream &stream, const Value &value);
+};
+
+#endif
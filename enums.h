@@ -9,11 +9,23 @@ const std::string optPrintText = "-T";
 const std::string optPrintLexemes = "-L";
 const std::string optPrintIdentifiers = "-I";
 const std::string optPrintRpn = "-R";
+const std::string optNoOptimize = "-O0";
+const std::string optPrintBytecode = "-B";
 const std::string optPrintStack = "-S";
 const std::string optPrintStackStepByStep = "-SS";
 const std::string optPrintAll = "-A";
 const std::string optPrintTime = "-t";
 const std::string optExecute = "-e";
+const std::string optProfile = "--profile";
+const std::string optStats = "--stats=";
+const std::string optCache = "--cache=";
+const std::string optBufferSize = "--buffer=";
+const std::string optBufferMode = "--buffer-mode=";
+
+#define BUFFER_MODE_LINE "line"
+#define BUFFER_MODE_FULL "full"
+
+#define STATS_FORMAT_JSON "json"
 
 // KEYWORDS
 #define LEX_PROGRAM "program"
@@ -106,6 +118,7 @@ enum class LexemeT {
 	rpn_decrement,
 
 	rpn_short_op,
+	rpn_cast,
 
 	rpn_go,
 	rpn_fgo,
@@ -113,6 +126,15 @@ enum class LexemeT {
 	rpn_address
 };
 
+enum class ScriptStatus {
+	ok,
+	no_lexemes,
+	syntax_error,
+	compile_error,
+	execution_error,
+	not_compiled
+};
+
 enum class IdentifierT {
 	identifier_unknown,
 	identifier_int,
@@ -121,6 +143,84 @@ enum class IdentifierT {
 	identifier_boolean
 };
 
+enum class OpCode {
+	nop,
+
+	push,
+	load,
+
+	minus_int,
+	minus_real,
+	increment,
+	decrement,
+
+	add_value_int,
+	sub_value_int,
+	mult_value_int,
+	div_value_int,
+
+	add_value_real,
+	sub_value_real,
+	mult_value_real,
+	div_value_real,
+
+	concat_value,
+
+	logic_not,
+
+	add_int,
+	sub_int,
+	mult_int,
+	div_int,
+	mod_int,
+
+	add_real,
+	sub_real,
+	mult_real,
+	div_real,
+
+	concat,
+
+	equal_int,
+	nequal_int,
+	less_int,
+	greater_int,
+	less_equal_int,
+	greater_equal_int,
+
+	equal_real,
+	nequal_real,
+	less_real,
+	greater_real,
+	less_equal_real,
+	greater_equal_real,
+
+	equal_string,
+	nequal_string,
+	less_string,
+	greater_string,
+
+	int_to_real,
+	real_to_int,
+	int_to_string,
+	real_to_string,
+
+	assign,
+	read,
+	write,
+
+	go,
+	fgo,
+
+	// superinstructions: fused sequences which are frequent in loops
+	slot_const_int, // load, push, int operation
+	slot_const_int_fgo, // load, push, int comparison, fgo
+	const_int_fgo, // push, int comparison, fgo
+	inc_go, // increment, go
+
+	halt // end of program, must be the last opcode
+};
+
 const std::vector <std::string> keywords = {
 	LEX_PROGRAM,
 	// io
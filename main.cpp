@@ -1,11 +1,16 @@
 #include <iostream>
 #include <string>
 #include <fstream>
-#include <ctime>
+#include <cstdio>
+#include <unistd.h>
 
 #include "analyzers/lexicalAnalyzer.h"
 #include "analyzers/syntaxAnalyzer.h"
+#include "analyzers/optimizer.h"
+#include "analyzers/compiler.h"
 #include "analyzers/executor.h"
+#include "entities/statistics.h"
+#include "entities/programCache.h"
 #include "enums.h"
 
 using namespace std;
@@ -27,7 +32,7 @@ void print(string s1, string s2) {
 		if (s2[i] != -47 && s2[i] != -48)
 			len2++;
 
-	printf("  %s%s%s%*s\n", BOLDBLUE, s1.c_str(), RESET, 16 - len1 + len2, s2.c_str());
+	printf("  %s%s%s%*s\n", BOLDBLUE, s1.c_str(), RESET, 24 - len1 + len2, s2.c_str());
 }
 
 void help() {
@@ -38,12 +43,20 @@ void help() {
 	print(optPrintText, "print interpreted text (your program)");
 	print(optPrintLexemes, "print processed lexemes");
 	print(optPrintIdentifiers, "print processed in lexical and syntax alalyze table of identifiers");
-	print(optPrintRpn, "print reverse polish notation of code");
+	print(optPrintRpn, "print reverse polish notation of code (before and after optimization)");
+	print(optNoOptimize, "disable optimization of reverse polish notation and instructions");
+	print(optPrintBytecode, "print compiled instructions of code");
 	print(optPrintStack, "print stack during code execution");
 	print(optPrintStackStepByStep, "print stack during code execution step by step");
 	print(optPrintAll, "print all available information");
 	print(optPrintTime, "print time for interpreting");
+	print(optStats + STATS_FORMAT_JSON, "print time of every phase and counters of program to stderr as JSON");
 	print(optExecute, "execute interpreted program");
+	print(optProfile, "print executed instructions and time for every line of program after execution");
+	print(optCache + "<dir>", "store compiled program in directory and execute it without analyzing if source isn't changed");
+	print(optBufferSize + "<bytes>", "size of buffer for written values (65536 by default, 0 - without buffer)");
+	print(optBufferMode + BUFFER_MODE_LINE, "write buffer at the end of every line (default for terminal)");
+	print(optBufferMode + BUFFER_MODE_FULL, "write buffer only when it is full (default for files and pipes)");
 	cout << endl;
 
 	cout << endl << "Additional information about language and syntax rules:" << endl << endl;
@@ -93,8 +106,8 @@ void help() {
 
 	cout << BOLDGREEN << "Logical operations:" << RESET << endl;
 	print(LEX_NOT, "not operation (only for boolean data type)");
-	print(LEX_AND, "and operation (only for boolean data type)");
-	print(LEX_OR, "or operation (only for boolean data type)");
+	print(LEX_AND, "and operation (only for boolean data type, right operand isn't evaluated if left one is false)");
+	print(LEX_OR, "or operation (only for boolean data type, right operand isn't evaluated if left one is true)");
 	cout << endl;
 
 	cout << BOLDGREEN << "Comparison operations:" << RESET << endl;
@@ -131,8 +144,16 @@ int main(int argc, char* argv[]) {
 	bool printLexemes = false;
 	bool printIdentifiers = false;
 	bool printRPN = false;
+	bool printBytecode = false;
 	bool printTime = false;
+	bool printStats = false;
 	bool execute = false;
+	bool optimize = true;
+	bool profile = false;
+
+	string cacheDirectory;
+	size_t bufferSize = 65536;
+	bool lineBuffered = isatty(fileno(stdout));
 
 	for (int i = 1; i < argc; i++) {
 		if (optPrintText == argv[i])
@@ -143,18 +164,34 @@ int main(int argc, char* argv[]) {
 			printIdentifiers = true;
 		else if (optPrintRpn == argv[i])
 			printRPN = true;
+		else if (optNoOptimize == argv[i])
+			optimize = false;
+		else if (optPrintBytecode == argv[i])
+			printBytecode = true;
 		else if (optPrintStack == argv[i])
 			printStack = 1;
 		else if (optPrintStackStepByStep == argv[i])
 			printStack = 2;
 		else if (optPrintTime == argv[i])
 			printTime = true;
+		else if (optStats + STATS_FORMAT_JSON == argv[i])
+			printStats = true;
 		else if (optPrintAll == argv[i]) {
-			printText = printLexemes = printIdentifiers = printRPN = true;
+			printText = printLexemes = printIdentifiers = printRPN = printBytecode = true;
 			printStack = 1;
 		}
 		else if (optExecute == argv[i])
 			execute = true;
+		else if (optProfile == argv[i])
+			profile = true;
+		else if (string(argv[i]).find(optBufferSize) == 0 && string(argv[i]).find_first_not_of("0123456789", optBufferSize.length()) == string::npos && string(argv[i]).length() > optBufferSize.length())
+			bufferSize = stoul(string(argv[i]).substr(optBufferSize.length()));
+		else if (string(argv[i]).find(optCache) == 0 && string(argv[i]).length() > optCache.length())
+			cacheDirectory = string(argv[i]).substr(optCache.length());
+		else if (optBufferMode + BUFFER_MODE_LINE == argv[i])
+			lineBuffered = true;
+		else if (optBufferMode + BUFFER_MODE_FULL == argv[i])
+			lineBuffered = false;
 		else if (path.empty())
 			path = argv[i];
 		else {
@@ -172,65 +209,133 @@ int main(int argc, char* argv[]) {
 		printStack = false;
 	}
 
+	if (profile && !execute) {
+		cout << BOLDYELLOW << "Warning: profiling is possible only at the execution of the program." << RESET << endl;
+		cout << "Use -e option to execute interpreted program or --help for more info." << endl;
+
+		profile = false;
+	}
+
 	try {
-		clock_t startClock = clock();
+		Statistics statistics;
 
 		ifstream sourceFile(path);
-		LexicalAnalyzer lexicalAnalyzer = LexicalAnalyzer(sourceFile);
 
-		vector<Lexeme>& lexemes = lexicalAnalyzer.analyze();
+		if (!sourceFile.good())
+			throw string("Error: incorrect file");
+
+		string sourceText {
+			istreambuf_iterator<char>(sourceFile), istreambuf_iterator<char>()
+		};
+
+		// cached program is used only when nothing but execution is requested
+		bool useCache = !cacheDirectory.empty() && !printText && !printLexemes && !printIdentifiers && !printRPN && !printBytecode && !printStack;
+		ProgramCache cache(cacheDirectory);
+		uint64_t cacheKey = cache.makeKey(sourceText, optimize);
 
-		if (lexemes.size() < 2) {
-			cout << "No lexemes founded" << endl;
-			return STATUS_NO_LEXEMES;
+		LexicalAnalyzer lexicalAnalyzer = LexicalAnalyzer(sourceText);
+		lexicalAnalyzer.printWarnings();
+		IdentifiersTable identifiersTable;
+		Program program;
+
+		if (useCache && cache.load(cacheKey, program)) {
+			statistics.endPhase("cache");
+			statistics.setCounter("cache_hit", 1);
 		}
+		else {
+			vector<Lexeme>& lexemes = lexicalAnalyzer.analyze();
 
-		if (printText)
-			lexicalAnalyzer.printText();
+			if (lexemes.size() < 2) {
+				cout << "No lexemes founded" << endl;
+				return STATUS_NO_LEXEMES;
+			}
 
-		if (printLexemes)
-			lexicalAnalyzer.printLexemes();
+			if (printText)
+				lexicalAnalyzer.printText();
 
-		if (printIdentifiers)
-			lexicalAnalyzer.printIdentifiers();
+			if (printLexemes)
+				lexicalAnalyzer.printLexemes();
 
-		clock_t lexicalClock = clock();
+			if (printIdentifiers)
+				lexicalAnalyzer.printIdentifiers();
 
-		// Syntax and semantic analyze
-		SyntaxAnalyzer syntaxAnalyzer(lexicalAnalyzer.getTextLines(), lexemes, lexicalAnalyzer.getIdentifiersTable());
+			statistics.endPhase("lexical");
+			statistics.setCounter("lexemes", lexemes.size() - 1);
 
-		if (!syntaxAnalyzer.analyze())
-			return STATUS_SYNTAX_ERRORS;
+			// Syntax and semantic analyze
+			SyntaxAnalyzer syntaxAnalyzer(lexicalAnalyzer.getTextLines(), lexemes, lexicalAnalyzer.getIdentifiersTable());
 
-		if (printIdentifiers)
-			syntaxAnalyzer.printIdentifiers();
+			if (!syntaxAnalyzer.analyze())
+				return STATUS_SYNTAX_ERRORS;
 
-		if (printRPN)
-			syntaxAnalyzer.printReversePolishNotation();
+			if (printIdentifiers)
+				syntaxAnalyzer.printIdentifiers();
 
-		clock_t syntaxClock = clock();
-		
-		if (execute) {
-			Executor executor(syntaxAnalyzer.getIdentifiersTable(), syntaxAnalyzer.getReversePolishNotation());
+			if (printRPN)
+				syntaxAnalyzer.printReversePolishNotation();
+
+			statistics.endPhase("syntax");
+
+			Optimizer optimizer(syntaxAnalyzer.getReversePolishNotation());
+			vector<Lexeme>& rpn = optimize ? optimizer.optimize() : syntaxAnalyzer.getReversePolishNotation();
+
+			if (printRPN && optimize)
+				optimizer.printReversePolishNotation();
 
-			executor.execute(printStack);
+			statistics.endPhase("optimize");
+			statistics.setCounter("rpn_lexemes", rpn.size());
+
+			Compiler compiler(syntaxAnalyzer.getIdentifiersTable(), rpn);
+			program = compiler.compile(optimize);
+
+			if (printBytecode)
+				compiler.printProgram();
+
+			identifiersTable = syntaxAnalyzer.getIdentifiersTable();
+
+			statistics.endPhase("compile");
+
+			if (useCache) {
+				cache.save(cacheKey, program);
+				statistics.setCounter("cache_hit", 0);
+			}
 		}
 
-		clock_t executeClock = clock();
+		statistics.setCounter("instructions", program.size());
+
+		if (execute) {
+			Executor executor(identifiersTable, program, bufferSize, lineBuffered);
+			Profiler profiler(lexicalAnalyzer.getTextLines().size());
+			ExecutionStats executionStats;
+
+			executor.execute(printStack, profile ? &profiler : nullptr, printStats ? &executionStats : nullptr);
+
+			if (profile)
+				profiler.print(lexicalAnalyzer.getTextLines());
+
+			statistics.endPhase("execute");
+			statistics.setCounter("executed_instructions", executionStats.instructions);
+			statistics.setCounter("peak_stack_depth", executionStats.peakStackSize);
+			statistics.setCounter("peak_bignum_digits", executionStats.peakDigits);
+			statistics.setCounter("threaded_dispatch", executionStats.threaded);
+		}
 
 		if (printTime) {
-			double lexicalTime = double (lexicalClock - startClock) / CLOCKS_PER_SEC;
-			double syntaxTime = double (syntaxClock - lexicalClock) / CLOCKS_PER_SEC;
-			double executeTime = double (executeClock - syntaxClock) / CLOCKS_PER_SEC;
+			double lexicalTime = statistics.getWallTime("lexical");
+			double syntaxTime = statistics.getWallTime("syntax") + statistics.getWallTime("optimize") + statistics.getWallTime("compile");
+			double executeTime = statistics.getWallTime("execute");
 
-			cout << endl << BOLDBLUE << "Lexical analyzer time: " << RESET << (lexicalTime * 1000000) << " us" << endl;
-			cout << BOLDBLUE << "Syntax analyzer time: " << RESET  << (syntaxTime * 1000000) << " us" << endl;
+			cout << endl << BOLDBLUE << "Lexical analyzer time: " << RESET << (lexicalTime * 1000) << " us" << endl;
+			cout << BOLDBLUE << "Syntax analyzer time: " << RESET  << (syntaxTime * 1000) << " us" << endl;
 
 			if (execute)
-				cout << BOLDBLUE << "Executor time: " << RESET  << (executeTime * 1000) << " ms" << endl;
+				cout << BOLDBLUE << "Executor time: " << RESET  << executeTime << " ms" << endl;
 
-			cout << BOLDBLUE << "Total perform time: " << RESET  << (lexicalTime + syntaxTime + executeTime) * 1000 << " ms" << endl;
+			cout << BOLDBLUE << "Total perform time: " << RESET  << (lexicalTime + syntaxTime + executeTime) << " ms" << endl;
 		}
+
+		if (printStats)
+			statistics.printJSON(stderr);
 	}
 	catch (string s) {
 		cout << BOLDRED << s << RESET << endl;